@@ -0,0 +1,1445 @@
+#ifndef __CORE_H__
+#define __CORE_H__
+
+// The whole core as a header, parameterized on the bus (see stCore below). cpu.cpp instantiates it
+// on BUS_READ / BUS_WRITE for the functions of cpu.h, a host can include it and instantiate it on
+// its own bus so the accesses are inlined into the opcode handlers
+
+#include <stddef.h>
+#include <string.h>
+
+#include "globals.h"
+#include "cpu.h"
+
+#ifdef CPU_RECOMPILER
+#include <stdint.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/*************************************************************/
+/*************************************************************/
+/************************ CPU TABLES *************************/
+/*************************************************************/
+/*************************************************************/
+// N / Z bits of P for every value. Decimal mode ADC / SBC is computed inline, a nibble at a time, with
+// the result in the low byte and N V Z C (P bit positions) in the high byte: it is rare in programs and
+// a table of every carry, A and operand would take 256KB per operation
+struct stTables {
+    u8  NZ[256];
+
+    stTables() {
+        for (int v = 0; v < 256; ++v) {
+            NZ[v] = (v & FLAG_N) | (v ? 0 : FLAG_Z);
+        }
+    }
+
+    // NMOS behaviour (http://www.6502.org/tutorials/decimal_mode.html), Z comes from the binary sum,
+    // N and V from the sum once the low nibble is adjusted
+    static u16 _decimal_adc(int a, int b, int c) {
+        int lo = (a & 0x0F) + (b & 0x0F) + c;
+        if (lo >= 0x0A) {
+            lo = ((lo + 0x06) & 0x0F) + 0x10;
+        }
+        int sum = (a & 0xF0) + (b & 0xF0) + lo;
+        int signedSum = (signed char)(a & 0xF0) + (signed char)(b & 0xF0) + lo;
+        u8 flags = (sum & 0x80) | (((a + b + c) & 0xFF) ? 0 : FLAG_Z);
+        if (signedSum < -128 || signedSum > 127) {
+            flags |= FLAG_V;
+        }
+        if (sum >= 0xA0) {
+            sum += 0x60;
+        }
+        if (sum >= 0x100) {
+            flags |= FLAG_C;
+        }
+        return (flags << 8) | (sum & 0xFF);
+    }
+
+    // Flags are the ones of the binary subtraction, only the result is adjusted
+    static u16 _decimal_sbc(int a, int b, int c) {
+        int bin = a - b - (1 - c);
+        int lo = (a & 0x0F) - (b & 0x0F) + c - 1;
+        if (lo < 0) {
+            lo = ((lo - 0x06) & 0x0F) - 0x10;
+        }
+        int sum = (a & 0xF0) - (b & 0xF0) + lo;
+        if (sum < 0) {
+            sum -= 0x60;
+        }
+        u8 flags = (bin & 0x80) | ((bin & 0xFF) ? 0 : FLAG_Z) | (bin >= 0 ? FLAG_C : 0);
+        if ((a ^ b) & (a ^ bin) & 0x80) {
+            flags |= FLAG_V;
+        }
+        return (flags << 8) | (sum & 0xFF);
+    }
+};
+
+/*************************************************************/
+/*************************************************************/
+/************************* CPU CORE **************************/
+/*************************************************************/
+/*************************************************************/
+// Bus provides the accesses that are not resolved by the memory map
+//    static u8   read(CPU_CTX_ u16 addr);
+//    static void write(CPU_CTX_ u16 addr, u8 data);
+//    static u32  idle(CPU_CTX_ u32 cycles);       (CPU_IDLE_DETECT, see BUS_IDLE)
+// Everything below is a static member, the functions of cpu.h have the same names and arguments
+// (stCore<Bus>::_cpu_run(budget)), the state (CPU / the machine, block cache, memory map) is the
+// same as with cpu.cpp. Every internal helper works on the register file it is given, the public
+// API passes the one of the machine (CPU_STATE), the execution loop passes a local copy so the
+// compiler can keep it in host registers
+template <class Bus>
+struct stCore {
+
+static stTables _cpu_tables;
+
+/*************************************************************/
+/*************************************************************/
+/******************* CPU ADDRESSING MODES ********************/
+/*************************************************************/
+/*************************************************************/
+// Every addressing mode is split in the operand fetch (done once when decoding a block, see
+// CPU_BLOCK_CACHE) and the address calculation that has to happen every time the instruction runs.
+// The modes themselves are types (see below), opcode handlers are instantiated for each of them
+typedef enum {
+    OPERAND_NONE,           // implied, accumulator
+    OPERAND_BYTE,           // zeropage (indexed), (indirect,x), (indirect),y
+    OPERAND_WORD,           // absolute (indexed), (indirect)
+    OPERAND_IMMEDIATE,      // the immediate value itself
+    OPERAND_RELATIVE        // branch target
+} CPU_OPERAND_KIND;
+
+#include "instructions.h"
+
+/*************************************************************/
+/*************************************************************/
+/********************** HELPER DEFINES ***********************/
+/*************************************************************/
+/*************************************************************/
+#define WRAP(val)                    ((val) & 0xFF)
+#define READ_ZP(addr)                (ZP_READ(WRAP(addr)))
+#define READ16_ZP(addr)              ( READ_ZP(addr) | (READ_ZP(addr+1) << 8))
+#define READ16_WRAP(addr)            (MEM_READ(addr) | ( MEM_READ(((addr) & 0xFF00) | WRAP(addr+1)) << 8))
+
+#define ADDR_ABSOLUTE                _cpu_addr_absolute
+#define ADDR_ABSOLUTE_X              _cpu_addr_absolute_x
+#define ADDR_ABSOLUTE_Y              _cpu_addr_absolute_y
+#define ADDR_ACCUMULATOR             _cpu_addr_accumulator
+#define ADDR_IMMEDIATE               _cpu_addr_immediate
+#define ADDR_IMPLIED                 _cpu_addr_implied
+#define ADDR_INDIRECT_X              _cpu_addr_indirect_x
+#define ADDR_INDIRECT                _cpu_addr_indirect
+#define ADDR_INDIRECT_Y              _cpu_addr_indirect_y
+#define ADDR_RELATIVE                _cpu_addr_relative
+#define ADDR_ZEROPAGE                _cpu_addr_zeropage
+#define ADDR_ZEROPAGE_X              _cpu_addr_zeropage_x
+#define ADDR_ZEROPAGE_Y              _cpu_addr_zeropage_y
+
+#define PAGE_DIFFER(a, b)            (!!(((a) ^ (b)) & 0xFF00))
+
+// Outside of the core P is the reference, the lazy flags are loaded from it when the core is
+// entered and folded back into it before the core returns
+#ifdef CPU_LAZY_FLAGS
+#define LAZY_FLAGS_LOAD()            SET_FLAGS(FLAGS)
+#define LAZY_FLAGS_STORE()           GET_FLAGS
+#else
+#define LAZY_FLAGS_LOAD()
+#define LAZY_FLAGS_STORE()
+#endif
+
+/*************************************************************/
+/*************************************************************/
+/********************* ADDRESSING MODES **********************/
+/*************************************************************/
+/*************************************************************/
+
+// https://en.wikipedia.org/wiki/MOS_Technology_6502#Addressing
+// Addressing modes also include
+//    implied (1 byte instructions);
+//    absolute (3 bytes);
+//    indexed absolute (3 bytes);
+//    indexed zero-page (2 bytes);
+//    relative (2 bytes);
+//    accumulator (1);
+//    indirect,x and indirect,y (2);
+//    and immediate (2)
+
+static CPU_INLINE u16 _cpu_operand(CPU_PARAM, u8 kind, u16 pc) {
+    switch (kind) {
+        case OPERAND_BYTE:
+        case OPERAND_IMMEDIATE:
+            return MEM_READ(pc + 1);
+        case OPERAND_WORD:
+            return READ16(pc + 1);
+        case OPERAND_RELATIVE: {
+            u16 offset = MEM_READ(pc + 1);
+            if (offset < 0x80) {
+                return pc + 2 + offset;
+            }
+            return pc + 2 + offset - 0x100;
+        }
+        default:
+            return 0;
+    }
+}
+
+// Each mode gives the operand kind to fetch, effective() turns the operand into the address the
+// handler works on (moving PC and adding the page crossing penalty), read() / write() access it.
+// Accumulator and immediate operands are resolved when the handler is instantiated, not at runtime
+struct _cpu_addr_memory {
+    static CPU_INLINE u8    read(CPU_PARAM, u16 addr)               { return MEM_READ(addr); }
+    static CPU_INLINE void  write(CPU_PARAM, u16 addr, u8 data)     { MEM_WRITE(addr, data); }
+};
+
+struct _cpu_addr_absolute : _cpu_addr_memory {
+    static const u8 Operand = OPERAND_WORD;
+    static CPU_INLINE u16 effective(CPU_PARAM, u16 operand, u8 pageCycles) {
+        UNUSED(pageCycles);
+        PC += 3;
+        return operand;
+    }
+};
+
+struct _cpu_addr_absolute_y : _cpu_addr_memory {
+    static const u8 Operand = OPERAND_WORD;
+    static CPU_INLINE u16 effective(CPU_PARAM, u16 operand, u8 pageCycles) {
+        u16 addr = operand + Y;
+        if (PAGE_DIFFER(operand, addr)) {
+            REG(Cycles) += pageCycles;
+            STATS_PAGE_CROSS(pageCycles);
+        }
+        PC += 3;
+        return addr;
+    }
+};
+
+struct _cpu_addr_absolute_x : _cpu_addr_memory {
+    static const u8 Operand = OPERAND_WORD;
+    static CPU_INLINE u16 effective(CPU_PARAM, u16 operand, u8 pageCycles) {
+        u16 addr = operand + X;
+        if (PAGE_DIFFER(operand, addr)) {
+            REG(Cycles) += pageCycles;
+            STATS_PAGE_CROSS(pageCycles);
+        }
+        PC += 3;
+        return addr;
+    }
+};
+
+struct _cpu_addr_accumulator {
+    static const u8 Operand = OPERAND_NONE;
+    static CPU_INLINE u16 effective(CPU_PARAM, u16 operand, u8 pageCycles) {
+        UNUSED(operand);
+        UNUSED(pageCycles);
+        PC++;
+        return 0;
+    }
+    static CPU_INLINE u8    read(CPU_PARAM, u16 addr)               { UNUSED(addr); return A; }
+    static CPU_INLINE void  write(CPU_PARAM, u16 addr, u8 data)     { UNUSED(addr); A = data; }
+};
+
+// The operand is the value itself, fetched along with the opcode
+struct _cpu_addr_immediate : _cpu_addr_memory {
+    static const u8 Operand = OPERAND_IMMEDIATE;
+    static CPU_INLINE u16 effective(CPU_PARAM, u16 operand, u8 pageCycles) {
+        UNUSED(pageCycles);
+        PC += 2;
+        return operand;
+    }
+    static CPU_INLINE u8    read(CPU_PARAM, u16 addr)               { UNUSED(cpu); return (u8)addr; }
+};
+
+struct _cpu_addr_implied : _cpu_addr_memory {
+    static const u8 Operand = OPERAND_NONE;
+    static CPU_INLINE u16 effective(CPU_PARAM, u16 operand, u8 pageCycles) {
+        UNUSED(operand);
+        UNUSED(pageCycles);
+        PC++;
+        return 0;
+    }
+};
+
+struct _cpu_addr_indirect_x : _cpu_addr_memory {
+    static const u8 Operand = OPERAND_BYTE;
+    static CPU_INLINE u16 effective(CPU_PARAM, u16 operand, u8 pageCycles) {
+        UNUSED(pageCycles);
+        PC += 2;
+        return READ16_ZP(operand + X);
+    }
+};
+
+struct _cpu_addr_indirect_y : _cpu_addr_memory {
+    static const u8 Operand = OPERAND_BYTE;
+    static CPU_INLINE u16 effective(CPU_PARAM, u16 operand, u8 pageCycles) {
+        u16 base = READ16_ZP(operand);
+        u16 addr = base + Y;
+        if (PAGE_DIFFER(base, addr)) {
+            REG(Cycles) += pageCycles;
+            STATS_PAGE_CROSS(pageCycles);
+        }
+        PC += 2;
+        return addr;
+    }
+};
+
+struct _cpu_addr_indirect : _cpu_addr_memory {
+    static const u8 Operand = OPERAND_WORD;
+    static CPU_INLINE u16 effective(CPU_PARAM, u16 operand, u8 pageCycles) {
+        UNUSED(pageCycles);
+        PC += 3;
+        return READ16_WRAP(operand);
+    }
+};
+
+struct _cpu_addr_relative : _cpu_addr_memory {
+    static const u8 Operand = OPERAND_RELATIVE;
+    static CPU_INLINE u16 effective(CPU_PARAM, u16 operand, u8 pageCycles) {
+        UNUSED(pageCycles);
+        PC += 2;
+        return operand;
+    }
+};
+
+struct _cpu_addr_zp_memory {
+    static CPU_INLINE u8    read(CPU_PARAM, u16 addr)               { return ZP_READ(addr); }
+    static CPU_INLINE void  write(CPU_PARAM, u16 addr, u8 data)     { ZP_WRITE(addr, data); }
+};
+
+struct _cpu_addr_zeropage : _cpu_addr_zp_memory {
+    static const u8 Operand = OPERAND_BYTE;
+    static CPU_INLINE u16 effective(CPU_PARAM, u16 operand, u8 pageCycles) {
+        UNUSED(pageCycles);
+        PC += 2;
+        return operand;
+    }
+};
+
+struct _cpu_addr_zeropage_x : _cpu_addr_zp_memory {
+    static const u8 Operand = OPERAND_BYTE;
+    static CPU_INLINE u16 effective(CPU_PARAM, u16 operand, u8 pageCycles) {
+        UNUSED(pageCycles);
+        PC += 2;
+        return (operand + X) & 0xFF;
+    }
+};
+
+struct _cpu_addr_zeropage_y : _cpu_addr_zp_memory {
+    static const u8 Operand = OPERAND_BYTE;
+    static CPU_INLINE u16 effective(CPU_PARAM, u16 operand, u8 pageCycles) {
+        UNUSED(pageCycles);
+        PC += 2;
+        return (operand + Y) & 0xFF;
+    }
+};
+
+/*************************************************************/
+/*************************************************************/
+/************************* SCHEDULER *************************/
+/*************************************************************/
+/*************************************************************/
+#ifndef CPU_MULTI_INSTANCE
+static stScheduler _cpu_scheduler;
+#endif
+
+#define CPU_EVENTS                   (CPU_SCHEDULER.Events)
+#define CPU_EVENT_COUNT              (CPU_SCHEDULER.EventCount)
+
+// Binary min-heap on When, the next event is always CPU_EVENTS[0]
+static void _cpu_event_up(CPU_CTX_ u32 i) {
+    stEvent* heap = CPU_EVENTS;
+    stEvent event = heap[i];
+    while (i) {
+        u32 parent = (i - 1) / 2;
+        if (heap[parent].When <= event.When) {
+            break;
+        }
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = event;
+}
+
+static void _cpu_event_down(CPU_CTX_ u32 i) {
+    stEvent* heap = CPU_EVENTS;
+    u32 count = CPU_EVENT_COUNT;
+    stEvent event = heap[i];
+    for (;;) {
+        u32 child = i * 2 + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && heap[child + 1].When < heap[child].When) {
+            child++;
+        }
+        if (event.When <= heap[child].When) {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = event;
+}
+
+// Slow path of the engines, on CPU_STATE. Runs the events that are due, takes the interrupt that is
+// pending (NMI first, IRQ lines only while I is clear) and moves End to the next event or the end of
+// the burst, whichever comes first. Returns false once the burst is over, or the CPU is halted (KIL)
+static bool _cpu_service(CPU_CTX_ u64 end) {
+    stCPU& cpu = CPU_STATE;
+    stScheduler& sched = CPU_SCHEDULER;
+    if (REG(Halted)) {
+        sched.End = 0;
+        return false;
+    }
+    bool woken = false;
+    while (CPU_EVENT_COUNT && CPU_EVENTS[0].When <= REG(Cycles)) {
+        stEvent event = CPU_EVENTS[0];
+        CPU_EVENTS[0] = CPU_EVENTS[--CPU_EVENT_COUNT];
+        _cpu_event_down(CPU_CTX_ARG_ 0);
+        event.Callback(CPU_CTX_ARG_ event.User, event.When);
+        woken = true;
+    }
+    if (sched.NMI || (sched.IRQ && !FI)) {
+        LAZY_FLAGS_LOAD();
+        if (sched.NMI) {
+            sched.NMI = 0;
+            _cpu_nmi(CPU_ARG);
+        }
+        else {
+            sched.IRQ &= ~CPU_IRQ_PULSE;
+            _cpu_irq(CPU_ARG);
+        }
+        LAZY_FLAGS_STORE();
+        woken = true;
+    }
+    if (woken) {
+        // The polled port may have changed, or the guest is not polling it anymore
+        IDLE_WAKE();
+    }
+    sched.End = end;
+    if (sched.EventCount && sched.Events[0].When < end) {
+        sched.End = sched.Events[0].When;
+    }
+    return REG(Cycles) < end && !IDLE_POLLING;
+}
+
+// Same on the local copy of an engine, spilled around the call
+static inline bool _cpu_service(CPU_PARAM, u64 end) {
+    LAZY_FLAGS_STORE();
+    CPU_STATE = cpu;
+    bool more = _cpu_service(CPU_CTX_ARG_ end);
+    cpu = CPU_STATE;
+    LAZY_FLAGS_LOAD();
+    return more;
+}
+
+static bool _cpu_scheduleAt(CPU_CTX_ u64 when, fpEvent callback, void* user) {
+    if (CPU_EVENT_COUNT == CPU_EVENTS_MAX) {
+        return false;
+    }
+    stEvent& event = CPU_EVENTS[CPU_EVENT_COUNT++];
+    event.When = when;
+    event.Callback = callback;
+    event.User = user;
+    _cpu_event_up(CPU_CTX_ARG_ CPU_EVENT_COUNT - 1);
+    if (when < CPU_SCHEDULER.End) {
+        CPU_SCHEDULER.End = when;
+    }
+    return true;
+}
+
+static bool _cpu_schedule(CPU_CTX_ u32 cycles, fpEvent callback, void* user) {
+    return _cpu_scheduleAt(CPU_CTX_ARG_ CPU_STATE.Cycles + cycles, callback, user);
+}
+
+// The heap is rebuilt from what is left, End may stay on a cancelled event (the service finds nothing to do)
+static void _cpu_cancel(CPU_CTX_ fpEvent callback, void* user) {
+    stEvent* heap = CPU_EVENTS;
+    u32 count = 0;
+    for (u32 i = 0; i < CPU_EVENT_COUNT; ++i) {
+        if (heap[i].Callback != callback || heap[i].User != user) {
+            heap[count++] = heap[i];
+        }
+    }
+    CPU_EVENT_COUNT = count;
+    for (u32 i = count / 2; i--; ) {
+        _cpu_event_down(CPU_CTX_ARG_ i);
+    }
+}
+
+/*************************************************************/
+/*************************************************************/
+/************************** DEVICES **************************/
+/*************************************************************/
+/*************************************************************/
+static void _cpu_syncDevice(CPU_CTX_ stDevice* device, u64 cycles) {
+    if (cycles > device->LastSync) {
+        if (device->Sync) {
+            device->Sync(CPU_CTX_ARG_ device, cycles);
+        }
+        device->LastSync = cycles;
+    }
+}
+
+static void _cpu_device_event(CPU_CTX_ void* user, u64 when) {
+    _cpu_syncDevice(CPU_CTX_ARG_ (stDevice*)user, when);
+}
+
+// Can be called from the Sync of the device itself (the next deadline is known once it caught up)
+static bool _cpu_scheduleDevice(CPU_CTX_ stDevice* device, u64 when) {
+    _cpu_cancel(CPU_CTX_ARG_ _cpu_device_event, device);
+    return _cpu_scheduleAt(CPU_CTX_ARG_ when, _cpu_device_event, device);
+}
+
+static void _cpu_cancelDevice(CPU_CTX_ stDevice* device) {
+    _cpu_cancel(CPU_CTX_ARG_ _cpu_device_event, device);
+}
+
+/*************************************************************/
+/*************************************************************/
+/******************** CPU IMPLEMENTATION *********************/
+/*************************************************************/
+/*************************************************************/
+
+// Interrupts push P with B clear, BRK is the one that sets it
+static inline void _cpu_nmi(CPU_PARAM) {
+    PUSH16(PC);
+    PUSH((GET_FLAGS & ~FLAG_B) | 0x20);
+    PC = READ16(INTERRUPT_NMI_VECTOR);
+    CALL_ENTER(SP + 3);
+    FI = 1;
+    REG(Cycles) += 7;
+}
+
+static inline void _cpu_irq(CPU_PARAM) {
+    PUSH16(PC);
+    PUSH((GET_FLAGS & ~FLAG_B) | 0x20);
+    PC = READ16(INTERRUPT_IRQ_VECTOR);
+    CALL_ENTER(SP + 3);
+    FI = 1;
+    REG(Cycles) += 7;
+}
+
+/*************************************************************/
+/*************************************************************/
+/*************************** STATS ***************************/
+/*************************************************************/
+/*************************************************************/
+#ifdef CPU_STATS
+
+#ifndef CPU_MULTI_INSTANCE
+static stStats _cpu_statistics;
+#endif
+
+static const stStats* _cpu_getStats(CPU_CTX) {
+    return &CPU_STATISTICS;
+}
+
+static void _cpu_clearStats(CPU_CTX) {
+    memset(&CPU_STATISTICS, 0, sizeof(stStats));
+}
+
+#endif
+
+/*************************************************************/
+/*************************************************************/
+/************************ CALL GRAPH *************************/
+/*************************************************************/
+/*************************************************************/
+#ifdef CPU_CALLGRAPH
+
+#ifndef CPU_MULTI_INSTANCE
+static stCallGraph _cpu_calls;
+#endif
+
+static const stCallGraph* _cpu_getCallGraph(CPU_CTX) {
+    return &CPU_CALLS;
+}
+
+static void _cpu_clearCallGraph(CPU_CTX) {
+    memset(&CPU_CALLS, 0, sizeof(stCallGraph));
+}
+
+static void _cpu_dropCalls(CPU_CTX) {
+    CPU_CALLS.Depth = 0;
+}
+
+// Closes the frames that started at or below sp, their return address is not on the stack anymore
+static void _cpu_callUnwind(stCallGraph& calls, u8 sp, u64 now) {
+    while (calls.Depth && calls.Frames[calls.Depth - 1].Base <= sp) {
+        const stCallFrame& frame = calls.Frames[--calls.Depth];
+        u64 inclusive = now > frame.Start ? now - frame.Start : 0;
+        calls.Exclusive[frame.Entry] += inclusive > frame.Children ? inclusive - frame.Children : 0;
+        // A recursion is only counted once, in its outermost call
+        bool nested = false;
+        for (u32 i = 0; i < calls.Depth && !nested; ++i) {
+            nested = calls.Frames[i].Entry == frame.Entry;
+        }
+        if (!nested) {
+            calls.Inclusive[frame.Entry] += inclusive;
+        }
+        if (calls.Depth) {
+            calls.Frames[calls.Depth - 1].Children += inclusive;
+        }
+    }
+}
+
+static void _cpu_callEnter(CPU_PARAM, u8 sp) {
+    stCallGraph& calls = CPU_CALLS;
+    // Frames left without a return (the stack was reset) are closed first
+    _cpu_callUnwind(calls, sp, REG(Cycles));
+    stCallFrame& frame = calls.Frames[calls.Depth++];
+    frame.Entry = PC;
+    frame.Base = sp;
+    frame.Start = REG(Cycles);
+    frame.Children = 0;
+    calls.Calls[PC]++;
+}
+
+static void _cpu_callReturn(CPU_PARAM) {
+    _cpu_callUnwind(CPU_CALLS, SP, REG(Cycles));
+}
+
+#endif
+
+static void _cpu_init(CPU_CTX) {
+    CPU_STATE.LastOpCode = 0;
+    CPU_STATE.Halted = 0;
+    CPU_SCHEDULER.End = 0;
+    CPU_SCHEDULER.IRQ = 0;
+    CPU_SCHEDULER.NMI = 0;
+    CPU_EVENT_COUNT = 0;
+    _cpu_flushCache(CPU_CTX_ARG);
+#ifdef CPU_STATS
+    _cpu_clearStats(CPU_CTX_ARG);
+#endif
+#ifdef CPU_CALLGRAPH
+    _cpu_clearCallGraph(CPU_CTX_ARG);
+#endif
+}
+
+static void _cpu_reset(CPU_CTX) {
+    stCPU& cpu = CPU_STATE;
+    SET_FLAGS(0x24);
+    A = X = Y = 0x00;
+    SP = 0xFD;
+    PC = READ16(INTERRUPT_RST_VECTOR);
+    REG(Halted) = 0;
+#ifdef CPU_CALLGRAPH
+    _cpu_dropCalls(CPU_CTX_ARG);
+#endif
+}
+
+#ifdef DEBUG
+    #define DEBUGINSTR(id, mnemonic) debug_nl("0x%04X\t%02X - %s\t\tA=%02x X=%02x Y=%02x P=%02x SP=%02x CYC=%llu", PC, id, mnemonic, A, X, Y, GET_FLAGS, SP, (unsigned long long)REG(Cycles));
+#else
+    #define DEBUGINSTR(id, mnemonic)
+#endif
+
+#define INSTR_EXEC(id, mnemonic, addr_handler, operand, page_cycles, handler) { DEBUGINSTR(id, mnemonic); handler<addr_handler>(CPU_ARG, addr_handler::effective(CPU_ARG, operand, page_cycles)); }
+#define INSTR_FETCH(addr_handler)    _cpu_operand(CPU_ARG, addr_handler::Operand, PC)
+
+// One instruction on the register file of the caller (lazy flags loaded), the switch engine and
+// _cpu_step both run it. With CPU_STATS this is where instructions and their cycles are counted
+static CPU_INLINE void _cpu_instr(CPU_PARAM) {
+    #define INSTR_CASE(id, mnemonic, addr_handler, size, cycles, page_cycles, handler) case id : { INSTR_EXEC(id, mnemonic, addr_handler, INSTR_FETCH(addr_handler), page_cycles, handler); REG(Cycles) += cycles; break; }
+
+#ifdef CPU_STATS
+    u64 start = REG(Cycles);
+#endif
+    REG(LastOpCode) = MEM_READ(PC);
+    switch (REG(LastOpCode))
+    {
+        #include "opcodes.h"
+        default:
+            break;
+    }
+    #undef INSTR_CASE
+
+#ifdef CPU_STATS
+    CPU_STATISTICS.Count[REG(LastOpCode)]++;
+    CPU_STATISTICS.Cycles[REG(LastOpCode)] += REG(Cycles) - start;
+#endif
+}
+
+static u32 _cpu_step(CPU_CTX) {
+    stCPU& cpu = CPU_STATE;
+    u64 start = REG(Cycles);
+    if (REG(Cycles) >= CPU_SCHEDULER.End) {
+        _cpu_service(CPU_CTX_ARG_ ~0ull);
+        if (REG(Halted)) {
+            return 0;                   // KIL, End stays at 0 while halted
+        }
+    }
+    LAZY_FLAGS_LOAD();
+    _cpu_instr(CPU_ARG);
+    LAZY_FLAGS_STORE();
+    return (u32)(REG(Cycles) - start);
+}
+
+/*************************************************************/
+/*************************************************************/
+/********************* DISPATCH ENGINES **********************/
+/*************************************************************/
+/*************************************************************/
+// Every engine runs on a local copy of the register file (state is spilled back to CPU only when
+// the burst ends, see CPU_BUS_SYNC for bus callbacks that need it earlier) and stops once it either
+// executed count instructions or consumed budget cycles, the last instruction can overshoot the budget.
+// Between two instructions the only test is Cycles against End, _cpu_service handles everything else
+// (events, interrupts, budget, idle loops). End starts at Cycles so a burst is serviced before it runs
+#define CPU_RUNNING                  (REG(Cycles) < CPU_SCHEDULER.End || _cpu_service(CPU_ARG, end))
+#define CPU_BURST_START()            u64 start = REG(Cycles); u64 end = start + budget; CPU_SCHEDULER.End = start
+
+#if defined(CPU_BLOCK_CACHE)
+
+// Predecoded basic blocks, a block is decoded once (opcode handler, operand, size and base cycles
+// of every instruction up to the next branch / jump) and executed straight from the cache. Code is
+// read from the host memory of the memory map, never through the bus: a block stops before an
+// instruction on an I/O page, and code running there is interpreted. Pages holding cached code are
+// flagged, the first write to one of them bumps the page generation and every block decoded from
+// that page is dropped the next time it is looked up. A page that keeps getting its code dropped
+// (self-modifying code, or code next to data as the CHRGET of EhBASIC in zero page) is interpreted
+// from then on, until _cpu_flushCache
+typedef u8  (*fpDecoded)(CPU_PARAM, u16);
+typedef u32 (*fpNative)(stCPU*);
+
+typedef struct {
+    fpDecoded Handler;
+    u8 Operand;                     // CPU_OPERAND_KIND
+    u8 Cycles;
+} stDecodeInfo;
+
+typedef struct {
+    fpDecoded Handler;
+    u16 Operand;
+    u8 OpCode;
+    u8 Size;
+    u8 Cycles;
+} stDecoded;
+
+typedef struct {
+    u16 Start;                      // Address of the first instruction
+    u16 End;                        // Address of the last byte of the last instruction
+    u8 Count;                       // Number of instructions, 0 for an empty slot or code that is interpreted
+    u32 Gen[2];                     // Generation of the first and last page when the block was decoded
+#ifdef CPU_RECOMPILER
+    u16 Hits;                       // Runs since the block was decoded
+    fpNative Native;                // Translated block, see recompiler.h
+#endif
+    stDecoded Instr[CPU_BLOCK_MAX];
+} stBlock;
+
+static stBlock  _cpu_blocks[CPU_BLOCK_CACHE_SIZE];
+static u32      _cpu_page_gen[256];
+static u8       _cpu_code_page[256];
+static u32      _cpu_code_writes;   // Bumped on every write to a page holding cached code
+static u8       _cpu_code_drops[256]; // Times the cached code of the page was dropped, up to CPU_BLOCK_DROPS
+
+#ifdef CPU_RECOMPILER
+#include "recompiler.h"
+#endif
+
+#define INSTR_CASE(id, mnemonic, addr_handler, size, cycles, page_cycles, handler) \
+    static u8 _cpu_decoded_##id(CPU_PARAM, u16 operand) { INSTR_EXEC(id, mnemonic, addr_handler, operand, page_cycles, handler); return cycles; }
+#include "opcodes.h"
+#undef INSTR_CASE
+
+// Anything that can move PC somewhere else than the next instruction ends a block
+static inline bool _cpu_block_end(u8 opcode, u8 operand) {
+    switch (opcode) {
+        case 0x00:                  // BRK
+        case 0x20:                  // JSR
+        case 0x40:                  // RTI
+        case 0x4c:                  // JMP
+        case 0x60:                  // RTS
+        case 0x6c:                  // JMP (ind)
+            return true;
+        default:
+            // Branches and KIL (x2 opcodes, except the immediate NOPs 82 / c2 / e2 and LDX a2)
+            return operand == OPERAND_RELATIVE || ((opcode & 0x0F) == 0x02 && (opcode < 0x80 || (opcode & 0x10)));
+    }
+}
+
+static void _cpu_block_decode(CPU_PARAM, stBlock& block, u16 pc) {
+    #define INSTR_CASE(id, mnemonic, addr_handler, size, cycles, page_cycles, handler) { _cpu_decoded_##id, addr_handler::Operand, cycles },
+    static const stDecodeInfo _cpu_decode_info[256] = {
+        #include "opcodes.h"
+    };
+    #undef INSTR_CASE
+
+    block.Start = pc;
+    block.Count = 0;
+#ifdef CPU_RECOMPILER
+    block.Hits = 0;
+    block.Native = NULL;
+#endif
+    while (block.Count < CPU_BLOCK_MAX) {
+        u8 bytes[3];
+        if (!_cpu_code(CPU_CTX_ARG_ pc, bytes, 1)) {
+            break;
+        }
+        const stDecodeInfo& info = _cpu_decode_info[bytes[0]];
+        u8 size = info.Operand == OPERAND_NONE ? 1 : info.Operand == OPERAND_WORD ? 3 : 2;
+        if (!_cpu_code(CPU_CTX_ARG_ (u16)(pc + 1), bytes + 1, size - 1) ||
+            _cpu_code_drops[pc >> 8] == CPU_BLOCK_DROPS || _cpu_code_drops[(u16)(pc + size - 1) >> 8] == CPU_BLOCK_DROPS) {
+            break;
+        }
+
+        stDecoded& instr = block.Instr[block.Count++];
+        instr.OpCode = bytes[0];
+        instr.Handler = info.Handler;
+        instr.Cycles = info.Cycles;
+        instr.Size = size;
+        switch (info.Operand) {
+            case OPERAND_WORD:
+                instr.Operand = bytes[1] | (bytes[2] << 8);
+                break;
+            case OPERAND_RELATIVE:
+                instr.Operand = (u16)(pc + 2 + bytes[1] - (bytes[1] < 0x80 ? 0 : 0x100));
+                break;
+            default:
+                instr.Operand = size == 2 ? bytes[1] : 0;
+                break;
+        }
+        pc += size;
+
+        if (_cpu_block_end(instr.OpCode, info.Operand)) {
+            break;
+        }
+    }
+    block.End = pc - 1;
+    if (!block.Count) {
+        return;
+    }
+
+    _cpu_code_page[block.Start >> 8] = _cpu_code_page[block.End >> 8] = 1;
+    block.Gen[0] = _cpu_page_gen[block.Start >> 8];
+    block.Gen[1] = _cpu_page_gen[block.End >> 8];
+}
+
+static CPU_INLINE stBlock& _cpu_block_lookup(CPU_PARAM, u16 pc) {
+    stBlock& block = _cpu_blocks[pc & (CPU_BLOCK_CACHE_SIZE - 1)];
+    if (block.Start != pc || !block.Count ||
+        block.Gen[0] != _cpu_page_gen[block.Start >> 8] ||
+        block.Gen[1] != _cpu_page_gen[block.End >> 8]) {
+        _cpu_block_decode(CPU_ARG, block, pc);
+    }
+    return block;
+}
+
+static inline void _cpu_block_write(u16 addr) {
+    u8 page = addr >> 8;
+    if (_cpu_code_page[page]) {
+        _cpu_code_page[page] = 0;
+        _cpu_page_gen[page]++;
+        _cpu_code_writes++;
+        if (_cpu_code_drops[page] < CPU_BLOCK_DROPS) {
+            _cpu_code_drops[page]++;
+        }
+    }
+}
+
+// End is checked after every instruction as in the other engines, a block is left in the middle when
+// the budget is over, an event is due or an interrupt got unmasked (CLI, PLP, RTI), the next lookup
+// decodes a block starting there
+static u32 _cpu_execute(CPU_CTX_ u32 count, u32 budget) {
+    stCPU cpu = CPU_STATE;
+    CPU_BURST_START();
+    LAZY_FLAGS_LOAD();
+    while (count && CPU_RUNNING) {
+        if (_cpu_code_drops[PC >> 8] == CPU_BLOCK_DROPS) {
+            // Code that keeps being rewritten, interpreted
+            _cpu_instr(CPU_ARG);
+            --count;
+            continue;
+        }
+        stBlock& block = _cpu_block_lookup(CPU_ARG, PC);
+        if (!block.Count) {
+            // Code on an I/O page
+            _cpu_instr(CPU_ARG);
+            --count;
+            continue;
+        }
+#ifdef CPU_RECOMPILER
+        if (!block.Native && ++block.Hits == CPU_RECOMPILE_THRESHOLD) {
+            block.Native = _jit_compile(block);
+        }
+        if (block.Native && count >= block.Count) {
+            count -= block.Native(&cpu);
+            continue;
+        }
+#endif
+        u32 writes = _cpu_code_writes;
+        for (u8 i = 0; i < block.Count && count; ++i, --count) {
+            const stDecoded& instr = block.Instr[i];
+            REG(LastOpCode) = instr.OpCode;
+            REG(Cycles) += instr.Handler(CPU_ARG, instr.Operand);
+            // The block just modified cached code (the rest of it may be stale), or something is due
+            if (writes != _cpu_code_writes || REG(Cycles) >= CPU_SCHEDULER.End) {
+                --count;
+                break;
+            }
+        }
+    }
+    LAZY_FLAGS_STORE();
+    CPU_STATE = cpu;
+    return (u32)(REG(Cycles) - start);
+}
+
+#elif CPU_DISPATCH == CPU_DISPATCH_THREADED
+
+// Direct threaded code, every handler fetches the next opcode and jumps straight to its label,
+// so each opcode gets its own indirect branch (and its own branch predictor entry)
+static u32 _cpu_execute(CPU_CTX_ u32 count, u32 budget) {
+    #define INSTR_CASE(id, mnemonic, addr_handler, size, cycles, page_cycles, handler) &&op_##id,
+    static void* const labels[256] = {
+        #include "opcodes.h"
+    };
+    #undef INSTR_CASE
+
+    #define DISPATCH()  { REG(LastOpCode) = MEM_READ(PC); goto *labels[REG(LastOpCode)]; }
+    #define INSTR_CASE(id, mnemonic, addr_handler, size, cycles, page_cycles, handler) \
+        op_##id : { INSTR_EXEC(id, mnemonic, addr_handler, INSTR_FETCH(addr_handler), page_cycles, handler); REG(Cycles) += cycles; if (--count && CPU_RUNNING) DISPATCH(); goto done; }
+
+    stCPU cpu = CPU_STATE;
+    CPU_BURST_START();
+    LAZY_FLAGS_LOAD();
+    if (count && CPU_RUNNING) {
+        DISPATCH();
+        #include "opcodes.h"
+    }
+    #undef INSTR_CASE
+    #undef DISPATCH
+done:
+    LAZY_FLAGS_STORE();
+    CPU_STATE = cpu;
+    return (u32)(REG(Cycles) - start);
+}
+
+#elif CPU_DISPATCH == CPU_DISPATCH_TABLE
+
+// Portable fallback, one function per opcode called through a table of function pointers
+typedef u8 (*fpOpcode)(CPU_PARAM);
+
+#define INSTR_CASE(id, mnemonic, addr_handler, size, cycles, page_cycles, handler) \
+    static u8 _cpu_op_##id(CPU_PARAM) { INSTR_EXEC(id, mnemonic, addr_handler, INSTR_FETCH(addr_handler), page_cycles, handler); return cycles; }
+#include "opcodes.h"
+#undef INSTR_CASE
+
+static u32 _cpu_execute(CPU_CTX_ u32 count, u32 budget) {
+    #define INSTR_CASE(id, mnemonic, addr_handler, size, cycles, page_cycles, handler) _cpu_op_##id,
+    static const fpOpcode _cpu_ops[256] = {
+        #include "opcodes.h"
+    };
+    #undef INSTR_CASE
+
+    stCPU cpu = CPU_STATE;
+    CPU_BURST_START();
+    LAZY_FLAGS_LOAD();
+    while (count-- && CPU_RUNNING) {
+        REG(LastOpCode) = MEM_READ(PC);
+        REG(Cycles) += _cpu_ops[REG(LastOpCode)](CPU_ARG);
+    }
+    LAZY_FLAGS_STORE();
+    CPU_STATE = cpu;
+    return (u32)(REG(Cycles) - start);
+}
+
+#else
+
+static u32 _cpu_execute(CPU_CTX_ u32 count, u32 budget) {
+    stCPU cpu = CPU_STATE;
+    CPU_BURST_START();
+    LAZY_FLAGS_LOAD();
+    while (count-- && CPU_RUNNING) {
+        _cpu_instr(CPU_ARG);
+    }
+    LAZY_FLAGS_STORE();
+    CPU_STATE = cpu;
+    return (u32)(REG(Cycles) - start);
+}
+
+#endif
+
+static u32 _cpu_exec(CPU_CTX_ u32 count) {
+    return _cpu_execute(CPU_CTX_ARG_ count, 0xFFFFFFFF);
+}
+
+static u32 _cpu_run(CPU_CTX_ u32 cycle_budget) {
+#ifdef CPU_IDLE_DETECT
+    // The first iteration seen is never taken as idle, part of it may have run before this burst
+    CPU_STATE.Idle = CPU_IDLE_ARMED | CPU_IDLE_BUSY;
+    u32 cycles = _cpu_execute(CPU_CTX_ARG_ 0xFFFFFFFF, cycle_budget);
+    if ((CPU_STATE.Idle & CPU_IDLE_LOOP) && cycles < cycle_budget) {
+        // Nothing changes until the I/O port does, the host sleeps through the rest of the budget
+        // (or less if input comes first, never past the next event) and the cycles it slept are skipped
+        u32 left = cycle_budget - cycles;
+        if (CPU_EVENT_COUNT && CPU_EVENTS[0].When < CPU_STATE.Cycles + left) {
+            left = CPU_EVENTS[0].When > CPU_STATE.Cycles ? (u32)(CPU_EVENTS[0].When - CPU_STATE.Cycles) : 0;
+        }
+        u32 skipped = left ? Bus::idle(CPU_CTX_ARG_ left) : 0;
+        if (skipped > left) {
+            skipped = left;
+        }
+        CPU_STATE.Cycles += skipped;
+        cycles += skipped;
+    }
+    CPU_STATE.Idle = 0;
+    return cycles;
+#else
+    return _cpu_execute(CPU_CTX_ARG_ 0xFFFFFFFF, cycle_budget);
+#endif
+}
+
+static void _cpu_flushCache(CPU_CTX) {
+#ifdef CPU_BLOCK_CACHE
+    for (int i = 0; i < 256; ++i) {
+        _cpu_code_page[i] = 0;
+        _cpu_code_drops[i] = 0;
+        _cpu_page_gen[i]++;
+    }
+    _cpu_code_writes++;
+#endif
+}
+
+/*************************************************************/
+/*************************************************************/
+/********************* ZERO PAGE / STACK *********************/
+/*************************************************************/
+/*************************************************************/
+#ifdef CPU_ZP_STACK_RAM
+
+#ifdef CPU_MULTI_INSTANCE
+#define CPU_ZP_STACK                 (machine->ZPStack)
+#else
+static u8* _cpu_zp_stack;
+#define CPU_ZP_STACK                 _cpu_zp_stack
+#endif
+
+static void _cpu_mapZPStack(CPU_CTX_ u8* mem) {
+    CPU_ZP_STACK = mem;
+    _cpu_flushCache(CPU_CTX_ARG);
+}
+
+#endif
+
+/*************************************************************/
+/*************************************************************/
+/************************ MEMORY MAP *************************/
+/*************************************************************/
+/*************************************************************/
+#ifdef CPU_MEMORY_MAP
+
+#ifdef CPU_MULTI_INSTANCE
+#define CPU_PAGES                    (machine->Pages)
+#else
+static stPage _cpu_pages[256];
+#define CPU_PAGES                    _cpu_pages
+#endif
+
+// addr is taken as the start of its page, mem (if any) holds the whole pages
+static void _cpu_map(CPU_CTX_ u16 addr, u32 size, const u8* read, u8* write, fpBusRead readIO, fpBusWrite writeIO, stDevice* device) {
+    u32 first = addr >> 8;
+    u32 count = (size + 0xFF) >> 8;
+    for (u32 i = 0; i < count && first + i < 256; ++i) {
+        stPage& page = CPU_PAGES[first + i];
+        page.Read = read ? read + (i << 8) : NULL;
+        page.Write = write ? write + (i << 8) : NULL;
+        page.ReadIO = readIO;
+        page.WriteIO = writeIO;
+        page.Device = device;
+    }
+#ifdef CPU_ZP_STACK_RAM
+    // Zero page and stack stay direct as long as both are one block of RAM
+    stPage* low = CPU_PAGES;
+    CPU_ZP_STACK = low[0].Write && low[1].Write == low[0].Write + 0x100 ? low[0].Write : NULL;
+#endif
+    _cpu_flushCache(CPU_CTX_ARG);
+}
+
+static void _cpu_mapRAM(CPU_CTX_ u16 addr, u32 size, u8* mem) {
+    _cpu_map(CPU_CTX_ARG_ addr, size, mem, mem, NULL, NULL, NULL);
+}
+
+static void _cpu_mapROM(CPU_CTX_ u16 addr, u32 size, const u8* mem) {
+    _cpu_map(CPU_CTX_ARG_ addr, size, mem, NULL, NULL, NULL, NULL);
+}
+
+static void _cpu_mapIO(CPU_CTX_ u16 addr, u32 size, fpBusRead read, fpBusWrite write) {
+    _cpu_map(CPU_CTX_ARG_ addr, size, NULL, NULL, read, write, NULL);
+}
+
+static void _cpu_mapDevice(CPU_CTX_ u16 addr, u32 size, stDevice* device) {
+    _cpu_map(CPU_CTX_ARG_ addr, size, NULL, NULL, NULL, NULL, device);
+}
+
+static void _cpu_unmap(CPU_CTX_ u16 addr, u32 size) {
+    _cpu_map(CPU_CTX_ARG_ addr, size, NULL, NULL, NULL, NULL, NULL);
+}
+
+// count bytes of code from addr for the block cache, straight from the host memory of their pages.
+// false when one is on an I/O page, reading it through the bus could have side effects
+static inline bool _cpu_code(CPU_CTX_ u16 addr, u8* bytes, u8 count) {
+    for (u8 i = 0; i < count; ++i) {
+        u16 at = (u16)(addr + i);
+        const u8* mem = CPU_PAGES[at >> 8].Read;
+        if (!mem) {
+            return false;
+        }
+        bytes[i] = mem[at & 0xFF];
+    }
+    return true;
+}
+
+#endif
+
+/*************************************************************/
+/*************************************************************/
+/************************ CPU HELPERS ************************/
+/*************************************************************/
+/*************************************************************/
+static CPU_INLINE void _cpu_push(CPU_PARAM, u8 data) {
+    ZP_WRITE(0x100 | SP,  data);
+    SP--; // This depends on 8 bit data to wrap; If another type use SP = WRAP(SP-1);
+}
+
+static CPU_INLINE u8 _cpu_pull(CPU_PARAM) {
+    SP++; // This depends on 8 bit data to wrap; If another type use SP = WRAP(SP+1);
+    return ZP_READ(0x100 | SP);
+}
+
+static CPU_INLINE u16 _cpu_pull16(CPU_PARAM) {
+    u8 lo = _cpu_pull(CPU_ARG);
+    return lo | (_cpu_pull(CPU_ARG) << 8);
+}
+
+static CPU_INLINE void _cpu_setN(CPU_PARAM, u8 data) {
+#ifdef CPU_LAZY_FLAGS
+    REG(ResultN) = data;
+#else
+    FN = (data >> 7);
+#endif
+}
+
+static CPU_INLINE void _cpu_setZ(CPU_PARAM, u8 data) {
+#ifdef CPU_LAZY_FLAGS
+    REG(ResultZ) = data;
+#else
+    FZ = (data == 0);
+#endif
+}
+
+static CPU_INLINE void _cpu_setNZ(CPU_PARAM, u8 data) {
+#ifdef CPU_LAZY_FLAGS
+    REG(ResultN) = REG(ResultZ) = data;
+#else
+    FLAGS = (FLAGS & ~(FLAG_N | FLAG_Z)) | _cpu_tables.NZ[data];
+#endif
+}
+
+// Binary ADC, SBC is the same with the operand inverted
+static CPU_INLINE void _cpu_add(CPU_PARAM, u8 val) {
+    u16 sum = A + val + FC;
+    FC = sum >> 8;
+    FV = !!(~(A ^ val) & (A ^ sum) & 0x80);
+    A = (u8)sum;
+    _cpu_setNZ(CPU_ARG, A);
+}
+
+// Decimal result of stTables, low byte is A and high byte N V Z C
+static CPU_INLINE void _cpu_setDecimal(CPU_PARAM, u16 result) {
+    u8 flags = result >> 8;
+    A = (u8)result;
+#ifdef CPU_LAZY_FLAGS
+    REG(ResultN) = flags;
+    REG(ResultZ) = !(flags & FLAG_Z);
+    FC = flags & FLAG_C;
+    FV = !!(flags & FLAG_V);
+#else
+    FLAGS = (FLAGS & ~(FLAG_N | FLAG_V | FLAG_Z | FLAG_C)) | flags;
+#endif
+}
+
+static CPU_INLINE void _cpu_adc(CPU_PARAM, u8 val) {
+    if (FD) {
+        _cpu_setDecimal(CPU_ARG, stTables::_decimal_adc(A, val, FC));
+        return;
+    }
+    _cpu_add(CPU_ARG, val);
+}
+
+static CPU_INLINE void _cpu_sbc(CPU_PARAM, u8 val) {
+    if (FD) {
+        _cpu_setDecimal(CPU_ARG, stTables::_decimal_sbc(A, val, FC));
+        return;
+    }
+    _cpu_add(CPU_ARG, ~val);
+}
+
+static CPU_INLINE u8 _cpu_getFlags(CPU_PARAM) {
+#ifdef CPU_LAZY_FLAGS
+    FLAG(N) = FN;
+    FLAG(Z) = FZ;
+    FLAG(C) = FC;
+    FLAG(V) = FV;
+#endif
+    return FLAGS;
+}
+
+static CPU_INLINE void _cpu_setFlags(CPU_PARAM, u8 flags) {
+    FLAGS = flags;
+#ifdef CPU_LAZY_FLAGS
+    REG(ResultN) = FLAG(N) << 7;
+    REG(ResultZ) = !FLAG(Z);
+    FC = FLAG(C);
+    FV = FLAG(V);
+#endif
+}
+
+static CPU_INLINE void _cpu_addBranchCycles(CPU_PARAM, u16 addr) {
+    REG(Cycles)++;
+    if (PAGE_DIFFER(PC, addr)) {
+        REG(Cycles)++;
+    }
+}
+
+// Polling loop detection, called for every branch taken. A backward branch ends an iteration of a
+// loop, it is a polling loop when the previous iteration was short, ended with the same branch and
+// registers, only read 0 from I/O and did not change memory (a JSR writing the same return address
+// over and over does not count). The next iterations can only differ once the I/O port does
+#ifdef CPU_IDLE_DETECT
+static CPU_INLINE void _cpu_idleBranch(CPU_PARAM, u16 addr) {
+    if (addr >= PC) {
+        return;
+    }
+    u32 regs = A | (X << 8) | (Y << 16) | ((u32)SP << 24);
+    u8 flags = GET_FLAGS;
+    if ((REG(Idle) & (CPU_IDLE_ARMED | CPU_IDLE_POLLED | CPU_IDLE_BUSY)) == (CPU_IDLE_ARMED | CPU_IDLE_POLLED) &&
+        REG(IdlePC) == addr && REG(IdleRegs) == regs && REG(IdleP) == flags &&
+        (u32)REG(Cycles) - REG(IdleCycles) <= CPU_IDLE_LOOP_CYCLES) {
+        REG(Idle) |= CPU_IDLE_LOOP;
+        CPU_SERVICE_NOW();
+    }
+    REG(Idle) &= ~(CPU_IDLE_POLLED | CPU_IDLE_BUSY);
+    REG(IdlePC) = addr;
+    REG(IdleRegs) = regs;
+    REG(IdleP) = flags;
+    REG(IdleCycles) = (u32)REG(Cycles);
+}
+#endif
+
+// Bus access from inside the core. With CPU_MEMORY_MAP, RAM and ROM pages are accessed directly,
+// everything else goes through _cpu_io_read / _cpu_io_write. With CPU_BUS_SYNC the bus callbacks
+// get to see (and change) the CPU, the local register file is spilled before the access and
+// reloaded after it, this is a no-op when the helpers already work on CPU_STATE
+static CPU_INLINE u8 _cpu_mem_read(CPU_PARAM, u16 addr) {
+#ifdef CPU_MEMORY_MAP
+    const u8* mem = CPU_PAGES[addr >> 8].Read;
+    if (mem) {
+        return mem[addr & 0xFF];
+    }
+#endif
+#ifdef CPU_BUS_SYNC
+    LAZY_FLAGS_STORE();
+    u8 data;
+    if (&cpu != &CPU_STATE) {
+        CPU_STATE = cpu;
+        data = _cpu_io_read(CPU_CTX_ARG_ addr, REG(Cycles));
+        cpu = CPU_STATE;
+    }
+    else {
+        data = _cpu_io_read(CPU_CTX_ARG_ addr, REG(Cycles));
+    }
+    LAZY_FLAGS_LOAD();
+#else
+    u8 data = _cpu_io_read(CPU_CTX_ARG_ addr, REG(Cycles));
+#endif
+    IDLE_MARK(data ? CPU_IDLE_BUSY : CPU_IDLE_POLLED);
+    return data;
+}
+
+static CPU_INLINE void _cpu_mem_write(CPU_PARAM, u16 addr, u8 data) {
+#ifdef CPU_BLOCK_CACHE
+    _cpu_block_write(addr);
+#endif
+#ifdef CPU_MEMORY_MAP
+    const stPage& page = CPU_PAGES[addr >> 8];
+    if (page.Write) {
+        IDLE_MARK(page.Write[addr & 0xFF] != data ? CPU_IDLE_BUSY : 0);
+        page.Write[addr & 0xFF] = data;
+        return;
+    }
+    if (page.Read) {
+        return;                     // ROM
+    }
+#endif
+    IDLE_MARK(CPU_IDLE_BUSY);
+#ifdef CPU_BUS_SYNC
+    LAZY_FLAGS_STORE();
+    if (&cpu != &CPU_STATE) {
+        CPU_STATE = cpu;
+        _cpu_io_write(CPU_CTX_ARG_ addr, data, REG(Cycles));
+        cpu = CPU_STATE;
+    }
+    else {
+        _cpu_io_write(CPU_CTX_ARG_ addr, data, REG(Cycles));
+    }
+    LAZY_FLAGS_LOAD();
+#else
+    _cpu_io_write(CPU_CTX_ARG_ addr, data, REG(Cycles));
+#endif
+}
+
+// Zero page and stack accesses, addr is below 0x200. Straight to host memory when the two pages
+// are declared RAM, through the memory map / bus otherwise (I/O mapped there keeps working)
+static CPU_INLINE u8 _cpu_zp_read(CPU_PARAM, u16 addr) {
+#ifdef CPU_ZP_STACK_RAM
+    const u8* mem = CPU_ZP_STACK;
+    if (mem) {
+        return mem[addr];
+    }
+#endif
+    return MEM_READ(addr);
+}
+
+static CPU_INLINE void _cpu_zp_write(CPU_PARAM, u16 addr, u8 data) {
+#ifdef CPU_ZP_STACK_RAM
+    u8* mem = CPU_ZP_STACK;
+    if (mem) {
+#ifdef CPU_BLOCK_CACHE
+        _cpu_block_write(addr);
+#endif
+        IDLE_MARK(mem[addr] != data ? CPU_IDLE_BUSY : 0);
+        mem[addr] = data;
+        return;
+    }
+#endif
+    MEM_WRITE(addr, data);
+}
+
+// Device or I/O handlers of the page when it has some, the Bus otherwise. cycles is the cycle count of
+// the accessing instruction, the device is synced to it first
+static inline u8 _cpu_io_read(CPU_CTX_ u16 addr, u64 cycles) {
+#ifdef CPU_MEMORY_MAP
+    const stPage& page = CPU_PAGES[addr >> 8];
+    if (page.Device) {
+        _cpu_syncDevice(CPU_CTX_ARG_ page.Device, cycles);
+        return page.Device->Read(CPU_CTX_ARG_ page.Device, addr);
+    }
+    if (page.ReadIO) {
+        return page.ReadIO(CPU_CTX_ARG_ addr);
+    }
+#else
+    UNUSED(cycles);
+#endif
+    return Bus::read(CPU_CTX_ARG_ addr);
+}
+
+static inline void _cpu_io_write(CPU_CTX_ u16 addr, u8 data, u64 cycles) {
+#ifdef CPU_MEMORY_MAP
+    const stPage& page = CPU_PAGES[addr >> 8];
+    if (page.Device) {
+        _cpu_syncDevice(CPU_CTX_ARG_ page.Device, cycles);
+        page.Device->Write(CPU_CTX_ARG_ page.Device, addr, data);
+        return;
+    }
+    if (page.WriteIO) {
+        page.WriteIO(CPU_CTX_ARG_ addr, data);
+        return;
+    }
+#else
+    UNUSED(cycles);
+#endif
+    Bus::write(CPU_CTX_ARG_ addr, data);
+}
+
+/*************************************************************/
+/*************************************************************/
+/************************** CPU API **************************/
+/*************************************************************/
+/*************************************************************/
+static void _cpu_push(CPU_CTX_ u8 data) {
+    stCPU& cpu = CPU_STATE;
+    _cpu_push(CPU_ARG, data);
+}
+
+static u8 _cpu_pull(CPU_CTX) {
+    stCPU& cpu = CPU_STATE;
+    return _cpu_pull(CPU_ARG);
+}
+
+static void _cpu_setN(CPU_CTX_ u8 data) {
+    stCPU& cpu = CPU_STATE;
+    LAZY_FLAGS_LOAD();
+    _cpu_setN(CPU_ARG, data);
+    LAZY_FLAGS_STORE();
+}
+
+static void _cpu_setZ(CPU_CTX_ u8 data) {
+    stCPU& cpu = CPU_STATE;
+    LAZY_FLAGS_LOAD();
+    _cpu_setZ(CPU_ARG, data);
+    LAZY_FLAGS_STORE();
+}
+
+static void _cpu_addBranchCycles(CPU_CTX_ u16 addr) {
+    stCPU& cpu = CPU_STATE;
+    _cpu_addBranchCycles(CPU_ARG, addr);
+}
+
+static void _cpu_triggerNMI(CPU_CTX) {
+    CPU_SCHEDULER.NMI = 1;
+    CPU_SERVICE_NOW();
+}
+
+// I is only tested by the service, CPU is not current when this is called from a bus callback
+static void _cpu_setIRQ(CPU_CTX_ u8 lines) {
+    CPU_SCHEDULER.IRQ |= lines;
+    CPU_SERVICE_NOW();
+}
+
+static void _cpu_clearIRQ(CPU_CTX_ u8 lines) {
+    CPU_SCHEDULER.IRQ &= ~lines;
+}
+
+static void _cpu_triggerIRQ(CPU_CTX) {
+    _cpu_setIRQ(CPU_CTX_ARG_ CPU_IRQ_PULSE);
+}
+
+};
+
+template <class Bus> stTables stCore<Bus>::_cpu_tables;
+
+#ifdef CPU_BLOCK_CACHE
+template <class Bus> typename stCore<Bus>::stBlock stCore<Bus>::_cpu_blocks[CPU_BLOCK_CACHE_SIZE];
+template <class Bus> u32 stCore<Bus>::_cpu_page_gen[256];
+template <class Bus> u8  stCore<Bus>::_cpu_code_page[256];
+template <class Bus> u8  stCore<Bus>::_cpu_code_drops[256];
+template <class Bus> u32 stCore<Bus>::_cpu_code_writes;
+#ifdef CPU_RECOMPILER
+template <class Bus> u8* stCore<Bus>::_jit_arena;
+template <class Bus> u32 stCore<Bus>::_jit_used;
+template <class Bus> bool stCore<Bus>::_jit_disabled;
+template <class Bus> u8* stCore<Bus>::_jit_pos;
+template <class Bus> typename stCore<Bus>::stJitFix stCore<Bus>::_jit_fixes[JIT_MAX_FIXES];
+template <class Bus> u32 stCore<Bus>::_jit_fix_count;
+#endif
+#endif
+
+#ifndef CPU_MULTI_INSTANCE
+template <class Bus> stScheduler stCore<Bus>::_cpu_scheduler;
+#ifdef CPU_STATS
+template <class Bus> stStats stCore<Bus>::_cpu_statistics;
+#endif
+#ifdef CPU_CALLGRAPH
+template <class Bus> stCallGraph stCore<Bus>::_cpu_calls;
+#endif
+#ifdef CPU_ZP_STACK_RAM
+template <class Bus> u8* stCore<Bus>::_cpu_zp_stack;
+#endif
+#ifdef CPU_MEMORY_MAP
+template <class Bus> stPage stCore<Bus>::_cpu_pages[256];
+#endif
+#endif
+
+#endif
@@ -42,7 +42,9 @@ typedef enum {
 /************************* CPU FLAGS *************************/
 /*************************************************************/
 /*************************************************************/
-#ifdef __LITTLE_ENDIAN__
+// Bit fields are allocated from the low bit on little endian targets (GCC, Clang, MSVC), the
+// flags byte has to match the 6502 P register (pushed by PHP / BRK, SET_NZ works on it directly)
+#if !(defined(__BIG_ENDIAN__) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__))
 typedef union {
     struct {
         u8 C : 1;
@@ -82,31 +84,254 @@ typedef struct {
     u8 Y;
     u8 SP;
     u16 PC;
-    u16 Address;                    // Calculated address based on Instruction addressing mode
-    CPU_ADDRESS_MODE Mode;
     CPU_INTR_MODE Interrupt;
     CPUFlags_t P;
+    u8 ResultN;                        // CPU_LAZY_FLAGS only, N / Z / C / V while the core runs, P is rebuilt from them on demand
+    u8 ResultZ;                        //     N is bit 7 of ResultN, Z is set when ResultZ is 0
+    u8 Carry;
+    u8 Overflow;
     u8 LastOpCode;
-    u32 Cycles;                        // It won't take long to overflow, (4*10^9)/(~4 ticks / instr) -> 10^9 instructions, @ 10Mhz -> 10^9/10^7 -> 10^2 (100 seconds), not too much time
+    u8 Halted;                         // Set by KIL, the CPU stays on it (and the engines return right away) until the next reset
+    u8 Idle;                           // CPU_IDLE_DETECT only, CPU_IDLE_* bits, registers, P and target of the last
+    u8 IdleP;                          //     backward branch taken and the low 32 bits of Cycles when it was taken
+    u16 IdlePC;
+    u32 IdleRegs;
+    u32 IdleCycles;
+    u64 Cycles;                        // 64 bit, u32 overflowed after ~7 minutes at 10MHz, this lasts ~58000 years
 } stCPU;
 
+/*************************************************************/
+/*************************************************************/
+/************************** MACHINE **************************/
+/*************************************************************/
+/*************************************************************/
+// CPU_MULTI_INSTANCE (define it before including "cpu.h") - instead of the single CPU / BUS_READ /
+// BUS_WRITE from "user_defines.h" every CPU method takes the machine it runs, so any number of them
+// can live in one process (one thread per machine, the core has no shared state in this mode)
+#ifdef CPU_MULTI_INSTANCE
+typedef struct stMachine stMachine;
+
+typedef u8   (*fpBusRead)(stMachine*, u16);
+typedef void (*fpBusWrite)(stMachine*, u16, u8);
+typedef u32  (*fpBusIdle)(stMachine*, u32);
+#else
+typedef u8   (*fpBusRead)(u16);
+typedef void (*fpBusWrite)(u16, u8);
+typedef u32  (*fpBusIdle)(u32);
+#endif
+
+#ifdef CPU_MULTI_INSTANCE
+#define CPU_CTX                 stMachine* machine
+#define CPU_CTX_                stMachine* machine,
+#else
+#define CPU_CTX                 void
+#define CPU_CTX_
+#endif
+
+/*************************************************************/
+/*************************************************************/
+/************************* SCHEDULER *************************/
+/*************************************************************/
+/*************************************************************/
+// Events are kept in a min-heap on the cycle they are due, the engines compare the cycle count with
+// the closest one (End) and leave their fast path only when it is reached. The callback runs between
+// two instructions, when is the cycle it was due (the CPU can be a few cycles past it). The scheduler
+// is not part of the register file, bus callbacks can raise / clear lines and schedule events without
+// CPU_BUS_SYNC (but only see the current CPU.Cycles with it)
+//    CPU_EVENTS_MAX - events pending at the same time, per machine
+#ifndef CPU_EVENTS_MAX
+#define CPU_EVENTS_MAX          32
+#endif
+
+typedef void (*fpEvent)(CPU_CTX_ void* user, u64 when);
+
+typedef struct {
+    u64 When;
+    fpEvent Callback;
+    void* User;
+} stEvent;
+
+// IRQ lines are levels (a device sets its line until it is acknowledged), the pulse of _cpu_triggerIRQ
+// is cleared when the IRQ is taken
+#define CPU_IRQ_LINE(n)         (1 << (n))          // 0 - 6
+#define CPU_IRQ_PULSE           0x80
+
+typedef struct {
+    u64 End;                           // Cycle the engines stop at (next event, end of the burst), 0 for right now
+    u8 IRQ;                            // IRQ lines that are set, taken while I is clear
+    u8 NMI;                            // Latched, taken at the next instruction boundary
+    u32 EventCount;
+    stEvent Events[CPU_EVENTS_MAX];    // Min-heap on When
+} stScheduler;
+
+/*************************************************************/
+/*************************************************************/
+/*************************** STATS ***************************/
+/*************************************************************/
+/*************************************************************/
+// CPU_STATS (define it before including "cpu.h") - counters per opcode since _cpu_init / _cpu_clearStats.
+// Cycles are those of the instructions (page crossings and branches included), not of the interrupts
+// taken between them. PageCross counts the extra cycle of abs,X / abs,Y / (ind),Y reads, Taken the
+// branches taken (Count - Taken were not). See stats.h to print them
+typedef struct {
+    u64 Count[256];
+    u64 Cycles[256];
+    u64 PageCross[256];
+    u64 Taken[256];
+} stStats;
+
+/*************************************************************/
+/*************************************************************/
+/************************ CALL GRAPH *************************/
+/*************************************************************/
+/*************************************************************/
+// CPU_CALLGRAPH (define it before including "cpu.h") - totals per subroutine entry address since
+// _cpu_init / _cpu_clearCallGraph. JSR, BRK and the interrupts open a frame on a shadow stack, it is
+// closed once SP is back above where the frame started: RTS / RTI, but also a routine that drops its
+// return address (PLA PLA) and returns to the caller of its caller, or the stack being reset. Cycles
+// of a call run from its JSR (or the interrupt) to the RTS / RTI, Inclusive only counts the outermost
+// call of a recursion, Exclusive leaves out the calls made from it
+typedef struct {
+    u16 Entry;
+    u8 Base;                           // SP before the return address was pushed
+    u64 Start;                         // Cycles at the call
+    u64 Children;                      // Inclusive cycles of the calls it made
+} stCallFrame;
+
+typedef struct {
+    u64 Calls[0x10000];
+    u64 Inclusive[0x10000];
+    u64 Exclusive[0x10000];
+    u32 Depth;
+    stCallFrame Frames[256];           // Base goes down from a frame to the next one, 256 is never reached
+} stCallGraph;
+
+/*************************************************************/
+/*************************************************************/
+/************************** DEVICES **************************/
+/*************************************************************/
+/*************************************************************/
+// A device keeps its own time (LastSync) and is only brought up to date when it matters, when the CPU
+// accesses one of its pages (to the cycle of the accessing instruction, see _cpu_mapDevice) or when its
+// next event is due (_cpu_scheduleDevice). Sync catches up from LastSync to the cycle it is given in one
+// go, the device costs nothing while the CPU runs code that does not touch it. Read / Write run right
+// after the sync, LastSync is then the current cycle (CPU.Cycles is not, without CPU_BUS_SYNC)
+typedef struct stDevice stDevice;
+
+typedef void (*fpDeviceSync)(CPU_CTX_ stDevice* device, u64 cycles);
+typedef u8   (*fpDeviceRead)(CPU_CTX_ stDevice* device, u16 addr);
+typedef void (*fpDeviceWrite)(CPU_CTX_ stDevice* device, u16 addr, u8 data);
+
+struct stDevice {
+    fpDeviceSync Sync;                 // NULL when the device has no state that moves with time
+    fpDeviceRead Read;
+    fpDeviceWrite Write;
+    void* User;                        // Free for the host, the core never touches it
+    u64 LastSync;                      // Cycle the state of the device is current to
+};
+
+/*************************************************************/
+/*************************************************************/
+/************************ MEMORY MAP *************************/
+/*************************************************************/
+/*************************************************************/
+// CPU_MEMORY_MAP (define it before including "cpu.h") - one entry per 256 byte page, RAM and ROM
+// pages are read (and RAM pages written) straight from host memory, I/O pages go to their handlers.
+// Pages left unmapped go to the bus (BUS_READ / BUS_WRITE or the callbacks of the machine)
+typedef struct {
+    const u8* Read;                    // Host memory of the page, NULL for I/O
+    u8* Write;                         // Host memory of the page, NULL for ROM and I/O
+    fpBusRead ReadIO;                  // I/O handlers, NULL to use the bus
+    fpBusWrite WriteIO;
+    stDevice* Device;                  // Synced and called instead of the I/O handlers
+} stPage;
+
+#ifdef CPU_MULTI_INSTANCE
+struct stMachine {
+    stCPU Cpu;
+    fpBusRead Read;
+    fpBusWrite Write;
+    void* User;                        // Free for the host, the core never touches it
+#ifdef CPU_MEMORY_MAP
+    stPage Pages[256];
+#endif
+#ifdef CPU_ZP_STACK_RAM
+    u8* ZPStack;
+#endif
+#ifdef CPU_IDLE_DETECT
+    fpBusIdle Idle;                    // NULL skips the idle cycles without waiting
+#endif
+    stScheduler Scheduler;
+#ifdef CPU_STATS
+    stStats Stats;
+#endif
+#ifdef CPU_CALLGRAPH
+    stCallGraph CallGraph;
+#endif
+};
+#endif
+
 /*************************************************************/
 /*************************************************************/
 /************************* CPU METHODS ***********************/
 /*************************************************************/
 /*************************************************************/
-void    _cpu_init();
-void    _cpu_reset();
-u32     _cpu_step();
-void    _cpu_push(u8);
-u8      _cpu_pull();
+void    _cpu_init(CPU_CTX);
+void    _cpu_reset(CPU_CTX);
+u32     _cpu_step(CPU_CTX);
+u32     _cpu_exec(CPU_CTX_ u32);
+u32     _cpu_run(CPU_CTX_ u32);
+void    _cpu_flushCache(CPU_CTX);
+void    _cpu_push(CPU_CTX_ u8);
+u8      _cpu_pull(CPU_CTX);
+
+void    _cpu_setN(CPU_CTX_ u8);
+void    _cpu_setZ(CPU_CTX_ u8);
+
+void    _cpu_addBranchCycles(CPU_CTX_ u16);
 
-void    _cpu_setN(u8);
-void    _cpu_setZ(u8);
+// Interrupts are latched and taken at the next instruction boundary (the IRQ once I is clear)
+void    _cpu_triggerNMI(CPU_CTX);
+void    _cpu_triggerIRQ(CPU_CTX);
+void    _cpu_setIRQ(CPU_CTX_ u8 lines);
+void    _cpu_clearIRQ(CPU_CTX_ u8 lines);
 
-void    _cpu_addBranchCycles(u16);
+// callback(user, when) once the cycle count reaches when (or cycles from now), false when CPU_EVENTS_MAX
+// events are already pending. _cpu_cancel drops every pending event with this callback and user
+bool    _cpu_schedule(CPU_CTX_ u32 cycles, fpEvent callback, void* user);
+bool    _cpu_scheduleAt(CPU_CTX_ u64 when, fpEvent callback, void* user);
+void    _cpu_cancel(CPU_CTX_ fpEvent callback, void* user);
 
-void    _cpu_triggerNMI();
-void    _cpu_triggerIRQ();
+// Brings the device to cycles (nothing when it is already there). The device has at most one event
+// pending, _cpu_scheduleDevice replaces it and syncs the device to when once it is due
+void    _cpu_syncDevice(CPU_CTX_ stDevice* device, u64 cycles);
+bool    _cpu_scheduleDevice(CPU_CTX_ stDevice* device, u64 when);
+void    _cpu_cancelDevice(CPU_CTX_ stDevice* device);
+
+#ifdef CPU_MEMORY_MAP
+// addr and size are rounded to whole pages, mem is the host memory for addr. Mapping flushes the block cache
+void    _cpu_mapRAM(CPU_CTX_ u16 addr, u32 size, u8* mem);
+void    _cpu_mapROM(CPU_CTX_ u16 addr, u32 size, const u8* mem);
+void    _cpu_mapIO(CPU_CTX_ u16 addr, u32 size, fpBusRead read, fpBusWrite write);
+void    _cpu_mapDevice(CPU_CTX_ u16 addr, u32 size, stDevice* device);
+void    _cpu_unmap(CPU_CTX_ u16 addr, u32 size);
+#endif
+
+#ifdef CPU_STATS
+const stStats* _cpu_getStats(CPU_CTX);
+void    _cpu_clearStats(CPU_CTX);
+#endif
+
+#ifdef CPU_CALLGRAPH
+const stCallGraph* _cpu_getCallGraph(CPU_CTX);
+void    _cpu_clearCallGraph(CPU_CTX);
+// Drops the open frames (_cpu_reset does it), after the host replaced the state of the CPU (snapshot)
+void    _cpu_dropCalls(CPU_CTX);
+#endif
+
+#ifdef CPU_ZP_STACK_RAM
+// Host memory of 0x0000 - 0x01FF (512 bytes of plain RAM), NULL when the two pages are not RAM
+void    _cpu_mapZPStack(CPU_CTX_ u8* mem);
+#endif
 
 #endif
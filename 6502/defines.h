@@ -4,11 +4,12 @@
 #define u8     unsigned char
 #define u16    unsigned short
 #define u32    unsigned int
-#define u64    unsigned long
+#define u64    unsigned long long
 
 #define i8     char
 #define i16    short
 #define i32    int
+#define i64    long long
 
 #define LO(v) (v && 0xFF)
 #define HI(v) (v >> 8)
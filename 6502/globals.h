@@ -11,14 +11,59 @@
 
 #define UNUSED(v)               (void)v
 
-#define PUSH16(v)               { _cpu_push((v) >> 8); _cpu_push((v) & 0xFF); }
-#define PULL16                  ( _cpu_pull() | _cpu_pull() << 8 )
-#define READ16(addr)            (BUS_READ(addr) | ((u16)BUS_READ(addr + 1) << 8))
-#define GET_FLAGS               _cpu_getFlags()
-#define SET_FLAGS(f)            _cpu_setFlags(f)
-#define REG(reg)                CPU.reg
-#define FLAG(val)               CPU.P.val
-#define ADDRESS                 CPU.Address
+// Helpers that get the local register file of the execution loop must be inlined, a call would
+// force the registers back to memory
+#if defined(_MSC_VER)
+#define CPU_INLINE              __forceinline
+#elif defined(__GNUC__)
+#define CPU_INLINE              inline __attribute__((always_inline))
+#else
+#define CPU_INLINE              inline
+#endif
+
+// Register file the core helpers and instruction handlers work on, with CPU_MULTI_INSTANCE they also
+// get the machine it belongs to. CPU_STATE is the register file of the machine, CPU_BUS_READ /
+// CPU_BUS_WRITE its bus
+#ifdef CPU_MULTI_INSTANCE
+#define CPU_PARAM               stMachine* machine, stCPU& cpu
+#define CPU_ARG                 machine, cpu
+#define CPU_STATE               (machine->Cpu)
+#define CPU_BUS_READ(addr)      machine->Read(machine, addr)
+#define CPU_BUS_WRITE(addr, v)  machine->Write(machine, addr, v)
+#define CPU_BUS_IDLE(cycles)    (machine->Idle ? machine->Idle(machine, cycles) : (cycles))
+#define CPU_CTX_ARG             machine
+#define CPU_CTX_ARG_            machine,
+#else
+#define CPU_PARAM               stCPU& cpu
+#define CPU_ARG                 cpu
+#define CPU_STATE               CPU
+#define CPU_BUS_READ(addr)      BUS_READ(addr)
+#define CPU_BUS_WRITE(addr, v)  BUS_WRITE(addr, v)
+#ifdef BUS_IDLE
+#define CPU_BUS_IDLE(cycles)    BUS_IDLE(cycles)
+#else
+#define CPU_BUS_IDLE(cycles)    (cycles)
+#endif
+#define CPU_CTX_ARG
+#define CPU_CTX_ARG_
+#endif
+
+// Bus access from inside the core (see _cpu_mem_read / _cpu_mem_write)
+#define MEM_READ(addr)          _cpu_mem_read(CPU_ARG, addr)
+#define MEM_WRITE(addr, val)    _cpu_mem_write(CPU_ARG, addr, val)
+
+// Zero page and stack (0x0000 - 0x01FF), direct with CPU_ZP_STACK_RAM (see _cpu_zp_read / _cpu_zp_write)
+#define ZP_READ(addr)           _cpu_zp_read(CPU_ARG, addr)
+#define ZP_WRITE(addr, val)     _cpu_zp_write(CPU_ARG, addr, val)
+
+#define PUSH16(v)               { _cpu_push(CPU_ARG, (v) >> 8); _cpu_push(CPU_ARG, (v) & 0xFF); }
+#define PULL16                  _cpu_pull16(CPU_ARG)
+#define READ16(addr)            (MEM_READ(addr) | ((u16)MEM_READ(addr + 1) << 8))
+#define GET_FLAGS               _cpu_getFlags(CPU_ARG)
+#define SET_FLAGS(f)            _cpu_setFlags(CPU_ARG, f)
+#define REG(reg)                cpu.reg
+#define FLAG(val)               REG(P).val
+#define ADDRESS                 address
 
 #define PC                      REG(PC)
 #define SP                      REG(SP)
@@ -27,15 +72,230 @@
 #define Y                       REG(Y)
 #define FLAGS                   REG(P).flags
 
+// CPU_LAZY_FLAGS - instructions only record the last result and the carry / overflow, the N Z C V
+// bits of P are rebuilt when something reads them (PHP, BRK, interrupts, the end of a burst).
+// Experimental, no gain measured over the table driven flags with GCC on x86-64 (README)
+#ifdef CPU_LAZY_FLAGS
+#define FN                      (REG(ResultN) >> 7)
+#define FZ                      (REG(ResultZ) == 0)
+#define FV                      REG(Overflow)
+#define FC                      REG(Carry)
+#else
 #define FN                      FLAG(N)
 #define FZ                      FLAG(Z)
 #define FV                      FLAG(V)
 #define FC                      FLAG(C)
+#endif
 #define FI                      FLAG(I)
 #define FD                      FLAG(D)
 
+// Bits of P
+#define FLAG_C                  0x01
+#define FLAG_Z                  0x02
+#define FLAG_I                  0x04
+#define FLAG_D                  0x08
+#define FLAG_B                  0x10
+#define FLAG_V                  0x40
+#define FLAG_N                  0x80
+
+/*************************************************************/
+/*************************************************************/
+/************************* DISPATCH **************************/
+/*************************************************************/
+/*************************************************************/
+// Engine used by _cpu_exec, can be selected in "user_defines.h". The switch is the fastest measured with
+// GCC on x86-64 (README, bench/basic), the other two are opt-in
+//    CPU_DISPATCH_SWITCH   - one switch on the opcode for every instruction (default)
+//    CPU_DISPATCH_THREADED - computed goto (GCC / Clang), falls back to CPU_DISPATCH_TABLE elsewhere
+//    CPU_DISPATCH_TABLE    - table of function pointers, one function per opcode
+#define CPU_DISPATCH_SWITCH     0
+#define CPU_DISPATCH_THREADED   1
+#define CPU_DISPATCH_TABLE      2
+
+#ifndef CPU_DISPATCH
+#define CPU_DISPATCH            CPU_DISPATCH_SWITCH
+#endif
+
+#if CPU_DISPATCH == CPU_DISPATCH_THREADED && !defined(__GNUC__)
+#undef  CPU_DISPATCH
+#define CPU_DISPATCH            CPU_DISPATCH_TABLE
+#endif
+
+/*************************************************************/
+/*************************************************************/
+/************************ BLOCK CACHE ************************/
+/*************************************************************/
+/*************************************************************/
+// Define CPU_BLOCK_CACHE in "user_defines.h" to run _cpu_exec / _cpu_run from predecoded basic blocks
+//    CPU_BLOCK_CACHE_SIZE  - number of cached blocks, must be a power of 2 (4096 with CPU_RECOMPILER, the
+//                            translation of a block is lost along with its slot)
+//    CPU_BLOCK_MAX         - maximum number of instructions in a block
+//    CPU_BLOCK_DROPS       - writes dropping the cached code of a page after which the page is interpreted
+#ifndef CPU_BLOCK_CACHE_SIZE
+#ifdef CPU_RECOMPILER
+#define CPU_BLOCK_CACHE_SIZE    4096
+#else
+#define CPU_BLOCK_CACHE_SIZE    1024
+#endif
+#endif
+
+#ifndef CPU_BLOCK_MAX
+#define CPU_BLOCK_MAX           16
+#endif
+
+#ifndef CPU_BLOCK_DROPS
+#define CPU_BLOCK_DROPS         16
+#endif
+
+/*************************************************************/
+/*************************************************************/
+/************************ RECOMPILER *************************/
+/*************************************************************/
+/*************************************************************/
+// Define CPU_RECOMPILER in "user_defines.h" to translate hot blocks into x86-64 code (see recompiler.h),
+// it turns on CPU_BLOCK_CACHE and is ignored on hosts that are not x86-64 Linux / macOS
+//    CPU_RECOMPILE_THRESHOLD - runs of a block before it gets translated
+//    CPU_RECOMPILER_ARENA    - bytes of executable memory, flushed when full
+#if defined(CPU_RECOMPILER) && !(defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__)))
+#undef  CPU_RECOMPILER
+#endif
+
+// The block cache and the recompiler keep their state in globals, they are not used with CPU_MULTI_INSTANCE
+#ifdef CPU_MULTI_INSTANCE
+#undef  CPU_BLOCK_CACHE
+#undef  CPU_RECOMPILER
+#endif
+
+// CPU_STATS counts in _cpu_instr, the block cache and the recompiler never go through it
+#ifdef CPU_STATS
+#undef  CPU_BLOCK_CACHE
+#undef  CPU_RECOMPILER
+#endif
+
+// The generated code works on the bits of P, not on the results CPU_LAZY_FLAGS keeps
+#ifdef CPU_LAZY_FLAGS
+#undef  CPU_RECOMPILER
+#endif
+
+#if defined(CPU_RECOMPILER) && !defined(CPU_BLOCK_CACHE)
+#define CPU_BLOCK_CACHE
+#endif
+
+// Code is decoded from the host memory of the memory map, never through the bus (a read there can be
+// I/O), the cache is left out without CPU_MEMORY_MAP
+#if defined(CPU_BLOCK_CACHE) && !defined(CPU_MEMORY_MAP)
+#undef  CPU_BLOCK_CACHE
+#undef  CPU_RECOMPILER
+#endif
+
+#ifndef CPU_RECOMPILE_THRESHOLD
+#define CPU_RECOMPILE_THRESHOLD 64
+#endif
+
+#ifndef CPU_RECOMPILER_ARENA
+#define CPU_RECOMPILER_ARENA    (1024 * 1024)
+#endif
+
+/*************************************************************/
+/*************************************************************/
+/************************ IDLE LOOPS *************************/
+/*************************************************************/
+/*************************************************************/
+// Define CPU_IDLE_DETECT in "user_defines.h" to have _cpu_run notice the guest polling an I/O port that
+// has nothing for it (a backward branch closing an iteration that only read 0 from I/O and left the
+// registers and memory as they were), the burst ends and the host gets the rest of the budget to
+// sleep through (BUS_IDLE). Needs CPU_MEMORY_MAP, I/O is whatever is not mapped as RAM / ROM
+//    CPU_IDLE_LOOP_CYCLES  - longest iteration taken as a polling loop
+#if defined(CPU_IDLE_DETECT) && !defined(CPU_MEMORY_MAP)
+#undef  CPU_IDLE_DETECT
+#endif
+
+#ifndef CPU_IDLE_LOOP_CYCLES
+#define CPU_IDLE_LOOP_CYCLES    64
+#endif
+
+// State of the detection (stCPU::Idle)
+#define CPU_IDLE_ARMED          0x01    // Inside _cpu_run, a polling loop ends the burst
+#define CPU_IDLE_POLLED         0x02    // An I/O read returned 0 in this iteration
+#define CPU_IDLE_BUSY           0x04    // Anything else did happen (I/O write, I/O read returning data, memory changed)
+#define CPU_IDLE_LOOP           0x08    // Polling loop found
+
+// Branches taken report to _cpu_idleBranch, accesses mark the iteration, the engines stop on a polling loop
+#ifdef CPU_IDLE_DETECT
+#define IDLE_BRANCH(addr)       _cpu_idleBranch(CPU_ARG, addr)
+#define IDLE_MARK(bits)         REG(Idle) |= (bits)
+#define IDLE_POLLING            (REG(Idle) & CPU_IDLE_LOOP)
+#define IDLE_WAKE()             REG(Idle) = (REG(Idle) & ~CPU_IDLE_LOOP) | CPU_IDLE_BUSY
+#else
+#define IDLE_BRANCH(addr)
+#define IDLE_MARK(bits)
+#define IDLE_POLLING            0
+#define IDLE_WAKE()
+#endif
+
+/*************************************************************/
+/*************************************************************/
+/************************* SCHEDULER *************************/
+/*************************************************************/
+/*************************************************************/
+// The engines run while Cycles is below End and call _cpu_service once it is reached (events due,
+// interrupts pending, end of the burst). Anything that makes the CPU leave its fast path early sets End
+// to 0, an instruction clearing I does it when an IRQ line is set so the IRQ is taken right after it
+#ifdef CPU_MULTI_INSTANCE
+#define CPU_SCHEDULER           (machine->Scheduler)
+#else
+#define CPU_SCHEDULER           _cpu_scheduler
+#endif
+
+#define CPU_SERVICE_NOW()       CPU_SCHEDULER.End = 0
+#define IRQ_UNMASKED()          { if (CPU_SCHEDULER.IRQ && !FI) CPU_SERVICE_NOW(); }
+
 #define INTERRUPT_NMI_VECTOR    0xFFFA
 #define INTERRUPT_IRQ_VECTOR    0xFFFE
 #define INTERRUPT_RST_VECTOR    0xFFFC
 
-#endif 
+/*************************************************************/
+/*************************************************************/
+/************************** STATS ****************************/
+/*************************************************************/
+/*************************************************************/
+// Define CPU_STATS in "user_defines.h" to count, for every opcode, the instructions executed and the
+// cycles they took, the page crossing penalties of abs,X / abs,Y / (ind),Y and the branches taken (see
+// stStats). The engines then run the switch on the opcode, without it nothing is counted or compiled in
+#ifdef CPU_STATS
+#undef  CPU_DISPATCH
+#define CPU_DISPATCH            CPU_DISPATCH_SWITCH
+#ifdef CPU_MULTI_INSTANCE
+#define CPU_STATISTICS          (machine->Stats)
+#else
+#define CPU_STATISTICS          _cpu_statistics
+#endif
+#define STATS_PAGE_CROSS(cycles) { if (cycles) CPU_STATISTICS.PageCross[REG(LastOpCode)]++; }
+#define STATS_BRANCH_TAKEN()    CPU_STATISTICS.Taken[REG(LastOpCode)]++
+#else
+#define STATS_PAGE_CROSS(cycles)
+#define STATS_BRANCH_TAKEN()
+#endif
+
+/*************************************************************/
+/*************************************************************/
+/************************ CALL GRAPH *************************/
+/*************************************************************/
+/*************************************************************/
+// Define CPU_CALLGRAPH in "user_defines.h" to count calls and cycles per subroutine (see stCallGraph).
+// JSR, BRK and the interrupts open a frame once PC is on the entry (sp is SP before they pushed
+// anything), RTS / RTI close the frames SP went back above
+#ifdef CPU_CALLGRAPH
+#ifdef CPU_MULTI_INSTANCE
+#define CPU_CALLS               (machine->CallGraph)
+#else
+#define CPU_CALLS               _cpu_calls
+#endif
+#define CALL_ENTER(sp)          _cpu_callEnter(CPU_ARG, sp)
+#define CALL_RETURN()           _cpu_callReturn(CPU_ARG)
+#else
+#define CALL_ENTER(sp)
+#define CALL_RETURN()
+#endif
+
+#endif
@@ -8,22 +8,28 @@
 
 //// https://sourceforge.net/p/nintendulator/code/HEAD/tree/nintendulator/trunk/src/CPU.cpp
 
-#define SET_N(v)                    _cpu_setN(v)
-#define SET_Z(v)                    _cpu_setZ(v)
-#define SETNZ(val)                  { SET_N(val); SET_Z(val); }
-#define READ                        BUS_READ(ADDRESS)
-#define WRITE(val)                  BUS_WRITE(ADDRESS, val)
-#define PUSH(val)                   _cpu_push(val)
-#define PULL                        _cpu_pull()
-#define ADD_BRANCH_CYCLES(ADDRESS)  _cpu_addBranchCycles(ADDRESS);
+#define SET_N(v)                    _cpu_setN(CPU_ARG, v)
+#define SET_Z(v)                    _cpu_setZ(CPU_ARG, v)
+#define SETNZ(val)                  _cpu_setNZ(CPU_ARG, val)
+#define READ                        M::read(CPU_ARG, ADDRESS)
+#define WRITE(val)                  M::write(CPU_ARG, ADDRESS, val)
+#define PUSH(val)                   _cpu_push(CPU_ARG, val)
+#define PULL                        _cpu_pull(CPU_ARG)
+#define ADD_BRANCH_CYCLES(ADDRESS)  _cpu_addBranchCycles(CPU_ARG, ADDRESS);
 #define _BV(val, bit)               ((val >> bit) & 1)
 #define COMPARE(a, b)               { SETNZ(a - b); FC = a >= b; }
 #define BRANCH(cond)                if (cond) {\
                                         ADD_BRANCH_CYCLES(ADDRESS);\
+                                        IDLE_BRANCH(ADDRESS);\
+                                        STATS_BRANCH_TAKEN();\
                                         PC = ADDRESS;\
                                     }
 
-#define INSTR(mnemonic)             void mnemonic(void)
+#define CALL(mnemonic)              mnemonic<M>(CPU_ARG, ADDRESS)
+
+// Every handler is instantiated for the addressing mode M of each opcode using it, M::read / M::write
+// go to the bus or to the accumulator and the effective address is passed in, not stored in CPU
+#define INSTR(mnemonic)             template <class M> static CPU_INLINE void mnemonic(CPU_PARAM, u16 ADDRESS)
 /*************************************************************/
 /*************************************************************/
 /**************** INSTRUCTION IMPLEMENTATION *****************/
@@ -31,16 +37,17 @@
 /*************************************************************/
 
 INSTR(PLP) {
-    FLAGS = (PULL & 0xEF) | 0x20;
+    SET_FLAGS((PULL & 0xEF) | 0x20);
+    IRQ_UNMASKED();
 }
 
 INSTR(PHP) {
-    PUSH(FLAGS | 0x10);
+    PUSH(GET_FLAGS | 0x10);
 }
 
 INSTR(CLC) { FC = 0; }
 INSTR(SEC) { FC = 1; }
-INSTR(CLI) { FI = 0; }
+INSTR(CLI) { FI = 0; IRQ_UNMASKED(); }
 INSTR(SEI) { FI = 1; }
 INSTR(CLV) { FV = 0; }
 INSTR(CLD) { FD = 0; }
@@ -62,23 +69,27 @@ INSTR(JMP) {PC = ADDRESS; }
 
 INSTR(BRK) {
     PUSH16(PC);
-    PHP();
-    SEI();
+    CALL(PHP);
+    CALL(SEI);
     PC = READ16(INTERRUPT_IRQ_VECTOR);
+    CALL_ENTER(SP + 3);
 }
 
 INSTR(RTS) {
     PC = PULL16 + 1;
+    CALL_RETURN();
 }
 
 INSTR(RTI) {
-    PLP();
+    CALL(PLP);
     PC = PULL16;
+    CALL_RETURN();
 }
 
 INSTR(JSR) {
     PUSH16(PC - 1);
     PC = ADDRESS;
+    CALL_ENTER(SP + 2);
 }
 
 INSTR(ORA) {
@@ -87,18 +98,11 @@ INSTR(ORA) {
 }
 
 INSTR(ASL) {
-    if (CPU.Mode == ACCUMULATOR) {
-        FC = _BV(A, 7);
-        A <<= 1;
-        SETNZ(A);
-    }
-    else {
-        u8 val_8 = READ;
-        FC = _BV(val_8, 7);
-        val_8 <<= 1;
-        WRITE(val_8);
-        SETNZ(val_8);
-    }
+    u8 val_8 = READ;
+    FC = _BV(val_8, 7);
+    val_8 <<= 1;
+    WRITE(val_8);
+    SETNZ(val_8);
 }
 
 INSTR(AND) {
@@ -116,18 +120,11 @@ INSTR(BIT) {
 
 INSTR(ROL) {
     u8 c = FC;
-    if (CPU.Mode == ACCUMULATOR) {
-        FC = _BV(A, 7);
-        A = (A << 1) | c;
-        SETNZ(A);
-    }
-    else {
-        u8 val_8 = READ;
-        FC = _BV(val_8, 7);
-        val_8 = (val_8 << 1) | c;
-        WRITE(val_8);
-        SETNZ(val_8);
-    }
+    u8 val_8 = READ;
+    FC = _BV(val_8, 7);
+    val_8 = (val_8 << 1) | c;
+    WRITE(val_8);
+    SETNZ(val_8);
 }
 
 INSTR(EOR) {
@@ -136,45 +133,24 @@ INSTR(EOR) {
 }
 
 INSTR(LSR) {
-    if (CPU.Mode == ACCUMULATOR) {
-        FC = A & 1;
-        A >>= 1;
-        SETNZ(A);
-    }
-    else {
-        u8 val_8 = READ;
-        FC = val_8 & 1;
-        val_8 >>= 1;
-        WRITE(val_8);
-        SETNZ(val_8);
-    }
+    u8 val_8 = READ;
+    FC = val_8 & 1;
+    val_8 >>= 1;
+    WRITE(val_8);
+    SETNZ(val_8);
 }
 
 INSTR(PHA) { PUSH(A); }
 
-INSTR(ADC) {
-    u8 val = READ;
-    u16 sum = A + val + FC;
-    FC = !!(sum & 0x100);
-    FV = !!(~(A ^ val) & (A ^ sum) & 0x80);
-    A = sum & 0xFF;
-    SETNZ(A);
-}
+INSTR(ADC) { _cpu_adc(CPU_ARG, READ); }
 
 INSTR(ROR) {
     u8 c = FC;
-    if (CPU.Mode == ACCUMULATOR) {
-        FC = A & 1;
-        A = (A >> 1) | (c << 7);
-        SETNZ(A);
-    }
-    else {
-        u8 val_8 = READ;
-        FC = val_8 & 1;
-        val_8 = (val_8 >> 1) | (c << 7);
-        WRITE(val_8);
-        SETNZ(val_8);
-    }
+    u8 val_8 = READ;
+    FC = val_8 & 1;
+    val_8 = (val_8 >> 1) | (c << 7);
+    WRITE(val_8);
+    SETNZ(val_8);
 }
 INSTR(PLA) {
     A = PULL;
@@ -249,14 +225,7 @@ INSTR(DEX) {
     SETNZ(X);
 }
 
-INSTR(SBC) {
-    u8 val = READ;
-    i16 sum = A + ~val + FC;
-    FV = !!((A ^ val) & (A ^ sum) & 0x80);
-    FC = !(sum & 0x100);
-    A = sum & 0xFF;
-    SETNZ(A);
-}
+INSTR(SBC) { _cpu_sbc(CPU_ARG, READ); }
 
 INSTR(INC) {
     u8 val_8 = READ + 1;
@@ -271,7 +240,7 @@ INSTR(INX) {
 
 
 INSTR(NOP) {/* Burn cycles */ }
-INSTR(KIL) {/* Nothing to do ?? Halt the processor ?? */ }
+INSTR(KIL) { PC--; REG(Halted) = 1; CPU_SERVICE_NOW(); /* Jams the CPU until a reset, PC stays on it */ }
 
 INSTR(AXS) {/* Unofficial instr */ }
 INSTR(TAS) {/* Unofficial instr */ }
@@ -291,11 +260,7 @@ INSTR(RRA) {
     u8 c = FC << 7;
     FC = tmp & 0x01;
     tmp = (tmp >> 1) | c;
-    i16 r = A + tmp + FC;
-    FV = !!(~(A ^ tmp) & (A ^ r) & 0x80);
-    FC = !!(r & 0x100);
-    A = r & 0xFF;
-    SETNZ(A);
+    _cpu_adc(CPU_ARG, tmp);
     WRITE(tmp);
 }
 
@@ -304,11 +269,7 @@ INSTR(ISC) {
     // INC + SBC
     u8 tmp = READ;
     tmp++;
-    i16 r = A + ~tmp + FC;
-    FV = !!((A ^ tmp) & (A ^ r) & 0x80);
-    FC = !(r & 0x100);
-    A = r & 0xFF;
-    SETNZ(A);
+    _cpu_sbc(CPU_ARG, tmp);
     WRITE(tmp);
 }
 
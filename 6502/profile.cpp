@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#ifndef _WIN32
+#include <signal.h>
+#include <sys/time.h>
+#endif
+
+#include "profile.h"
+
+/*************************************************************/
+/*************************************************************/
+/*************************** TIMER ***************************/
+/*************************************************************/
+/*************************************************************/
+// Ticks of the timer not sampled yet, the signal handler only adds to it (lock-free, safe in a handler)
+static std::atomic<u32> _profile_ticks;
+
+#ifndef _WIN32
+static void _profile_signal(int sig) {
+    (void)sig;
+    _profile_ticks.fetch_add(1, std::memory_order_relaxed);
+}
+#endif
+
+bool _profile_start(u32 hz) {
+    if (!hz || hz > 1000000) {
+        return false;
+    }
+#ifdef _WIN32
+    return false;
+#else
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = _profile_signal;
+    action.sa_flags = SA_RESTART;      // Reads / writes of the host go on, sleeps can end early
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, NULL)) {
+        return false;
+    }
+    struct itimerval timer;
+    // tv_usec must stay under a second, 1 Hz is tv_sec = 1
+    timer.it_interval.tv_sec = 1 / hz;
+    timer.it_interval.tv_usec = (1000000 / hz) % 1000000;
+    timer.it_value = timer.it_interval;
+    _profile_ticks = 0;
+    return setitimer(ITIMER_PROF, &timer, NULL) == 0;
+#endif
+}
+
+void _profile_stop() {
+#ifndef _WIN32
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, NULL);
+    signal(SIGPROF, SIG_IGN);
+#endif
+}
+
+/*************************************************************/
+/*************************************************************/
+/************************** SAMPLES **************************/
+/*************************************************************/
+/*************************************************************/
+#define PROFILE_JSR                 0x20
+
+// PC then the call sites (the JSR, 3 bytes before the return address), innermost first
+typedef std::vector<u16> tStack;
+
+static std::map<tStack, u64> _profile_stacks;
+static u64 _profile_total;
+
+// Return addresses between SP and the top of the stack page
+static void _profile_walk(const stCPU* cpu, fpRead read, tStack* stack) {
+    u32 at = (u32)cpu->SP + 1;
+    while (at < 0xFF && stack->size() <= PROFILE_DEPTH) {
+        u16 ret = (u16)(read((u16)(0x100 + at)) | (read((u16)(0x100 + at + 1)) << 8));
+        u16 call = (u16)(ret - 2);
+        if (read(call) == PROFILE_JSR) {
+            stack->push_back(call);
+            at += 2;
+        }
+        else {
+            at++;
+        }
+    }
+}
+
+void _profile_sample(const stCPU* cpu, fpRead read) {
+    if (!_profile_ticks.load(std::memory_order_relaxed)) {
+        return;
+    }
+    u32 ticks = _profile_ticks.exchange(0);
+    tStack stack;
+    stack.reserve(PROFILE_DEPTH + 1);
+    stack.push_back(cpu->PC);
+    _profile_walk(cpu, read, &stack);
+    _profile_stacks[stack] += ticks;
+    _profile_total += ticks;
+}
+
+u64 _profile_samples() {
+    return _profile_total;
+}
+
+/*************************************************************/
+/*************************************************************/
+/************************** SYMBOLS **************************/
+/*************************************************************/
+/*************************************************************/
+// Sorted on the address
+static std::vector<std::pair<u16, std::string> > _profile_labels;
+
+// "$C1A2", "0xC1A2" or, when hex is set, "C1A2" / "00C1A2"
+static bool _profile_address(const std::string& token, bool hex, u16* addr) {
+    size_t from = 0;
+    if (token[0] == '$') {
+        from = 1;
+    }
+    else if (token.size() > 2 && token[0] == '0' && (token[1] == 'x' || token[1] == 'X')) {
+        from = 2;
+    }
+    else if (!hex) {
+        return false;
+    }
+    if (from == token.size() || token.size() - from > 6) {
+        return false;
+    }
+    u32 value = 0;
+    for (size_t i = from; i < token.size(); ++i) {
+        if (!isxdigit((unsigned char)token[i])) {
+            return false;
+        }
+        value = value * 16 + (isdigit((unsigned char)token[i]) ? token[i] - '0' : (toupper((unsigned char)token[i]) - 'A' + 10));
+    }
+    if (value > 0xFFFF) {
+        return false;
+    }
+    *addr = (u16)value;
+    return true;
+}
+
+bool _profile_symbols(const char* path) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        std::vector<std::string> tokens;
+        std::string token;
+        for (size_t i = 0; i <= line.size(); ++i) {
+            char c = i < line.size() ? line[i] : ' ';
+            if (isspace((unsigned char)c) || c == '=' || c == ':') {
+                if (!token.empty()) {
+                    tokens.push_back(token);
+                    token.clear();
+                }
+            }
+            else {
+                token += c;
+            }
+        }
+        if (tokens.size() && tokens[0] == "al") {
+            tokens.erase(tokens.begin());
+        }
+        if (tokens.size() < 2 || tokens[0][0] == ';' || tokens[0][0] == '#') {
+            continue;
+        }
+        // A $ / 0x address wins, then a bare hex one (a label can be made of hex digits too)
+        u16 addr;
+        int name = -1;
+        for (int hex = 0; hex < 2 && name < 0; ++hex) {
+            if (_profile_address(tokens[0], hex != 0, &addr)) {
+                name = 1;
+            }
+            else if (_profile_address(tokens[1], hex != 0, &addr)) {
+                name = 0;
+            }
+        }
+        if (name < 0) {
+            continue;
+        }
+        std::string label = tokens[name];
+        if (label[0] == '.') {
+            label.erase(0, 1);
+        }
+        _profile_labels.push_back(std::make_pair(addr, label));
+    }
+    std::stable_sort(_profile_labels.begin(), _profile_labels.end(),
+        [](const std::pair<u16, std::string>& a, const std::pair<u16, std::string>& b) { return a.first < b.first; });
+    return true;
+}
+
+// Closest label at or before addr, the address itself without one
+static std::string _profile_name(u16 addr) {
+    std::vector<std::pair<u16, std::string> >::const_iterator label = std::upper_bound(_profile_labels.begin(), _profile_labels.end(), addr,
+        [](u16 a, const std::pair<u16, std::string>& b) { return a < b.first; });
+    if (label != _profile_labels.begin()) {
+        return (label - 1)->second;
+    }
+    char hex[8];
+    snprintf(hex, sizeof(hex), "$%04X", addr);
+    return hex;
+}
+
+/*************************************************************/
+/*************************************************************/
+/*************************** WRITE ***************************/
+/*************************************************************/
+/*************************************************************/
+// Stacks that name the same frames are merged, the outermost frame comes first
+bool _profile_write(const char* path) {
+    std::map<std::string, u64> folded;
+    for (std::map<tStack, u64>::const_iterator it = _profile_stacks.begin(); it != _profile_stacks.end(); ++it) {
+        std::string line;
+        for (size_t i = it->first.size(); i-- > 0;) {
+            line += _profile_name(it->first[i]);
+            if (i) {
+                line += ';';
+            }
+        }
+        folded[line] += it->second;
+    }
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+    for (std::map<std::string, u64>::const_iterator it = folded.begin(); it != folded.end(); ++it) {
+        fprintf(file, "%s %llu\n", it->first.c_str(), (unsigned long long)it->second);
+    }
+    return fclose(file) == 0;
+}
+
+/*************************************************************/
+/*************************************************************/
+/************************ CALL GRAPH *************************/
+/*************************************************************/
+/*************************************************************/
+void _profile_calls(FILE* file, const stCallGraph* calls) {
+    std::vector<u16> entries;
+    u64 total = 0;
+    for (u32 i = 0; i < 0x10000; ++i) {
+        if (calls->Calls[i] || calls->Exclusive[i]) {
+            entries.push_back((u16)i);
+            total += calls->Exclusive[i];
+        }
+    }
+    std::stable_sort(entries.begin(), entries.end(),
+        [calls](u16 a, u16 b) { return calls->Exclusive[a] > calls->Exclusive[b]; });
+
+    fprintf(file, "%u subroutines, %llu cycles\n", (u32)entries.size(), (unsigned long long)total);
+    fprintf(file, "%-16s %12s %14s %7s %14s %7s %10s\n", "entry", "calls", "inclusive", "", "exclusive", "", "per call");
+    for (size_t i = 0; i < entries.size(); ++i) {
+        u16 entry = entries[i];
+        std::string name = _profile_name(entry);
+        if (name[0] != '$') {
+            char hex[8];
+            snprintf(hex, sizeof(hex), " $%04X", entry);
+            name += hex;
+        }
+        u64 count = calls->Calls[entry];
+        fprintf(file, "%-16s %12llu %14llu %6.2f%% %14llu %6.2f%% %10.1f\n", name.c_str(), (unsigned long long)count,
+                (unsigned long long)calls->Inclusive[entry], total ? calls->Inclusive[entry] * 100.0 / total : 0.0,
+                (unsigned long long)calls->Exclusive[entry], total ? calls->Exclusive[entry] * 100.0 / total : 0.0,
+                count ? (double)calls->Inclusive[entry] / count : 0.0);
+    }
+}
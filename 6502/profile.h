@@ -0,0 +1,59 @@
+#ifndef __PROFILE_H__
+#define __PROFILE_H__
+
+#include <stdio.h>
+
+#include "defines.h"
+#include "cpu.h"
+
+/*************************************************************/
+/*************************************************************/
+/************************** PROFILE **************************/
+/*************************************************************/
+/*************************************************************/
+// Sampling profiler for the guest, cheap enough to leave on. A host timer (SIGPROF, on the CPU time of
+// the process) only counts ticks, the host looks at them between two bursts: when one went off the
+// sample is PC and the return addresses found on the stack page, weighted by the ticks since the last
+// one. The stack has no frames, a pair of bytes is taken as a return address when the 3 bytes before
+// it are a JSR, up to PROFILE_DEPTH of them (data pushed by the guest can look like one now and then).
+// The samples are written as collapsed stacks, one line per stack (outermost caller first, counts at
+// the end), what flamegraph.pl and speedscope read:
+//
+//    _profile_start(PROFILE_HZ);
+//    while (running) {
+//        _cpu_run(budget);
+//        _profile_sample(&CPU, read);          // read(addr) without side effects, ROM included
+//    }
+//    _profile_stop();
+//    _profile_symbols("ehbasic.sym");          // optional
+//    _profile_write("basic.folded");
+//
+// Without symbols every frame is an address ($C1A2), with them it is the closest label at or before
+// it. The symbol file has one label per line as assemblers and linkers write them: "LAB_1234 = $C1A2",
+// "al 00C1A2 .LAB_1234" (VICE / ld65 -Ln) or "C1A2 LAB_1234", lines starting with ; or # are skipped
+//    PROFILE_HZ    - default sampling rate
+//    PROFILE_DEPTH - return addresses kept per sample
+#ifndef PROFILE_HZ
+#define PROFILE_HZ                  1000
+#endif
+
+#ifndef PROFILE_DEPTH
+#define PROFILE_DEPTH               8
+#endif
+
+// false where the timer is not available (Windows)
+bool    _profile_start(u32 hz);
+void    _profile_stop();
+// Records a sample when the timer went off since the last call, nothing else
+void    _profile_sample(const stCPU* cpu, fpRead read);
+u64     _profile_samples();
+// false when the file cannot be read, labels of an earlier file are kept
+bool    _profile_symbols(const char* path);
+bool    _profile_write(const char* path);
+
+// Totals of a CPU_CALLGRAPH build (_cpu_getCallGraph), one line per subroutine sorted on exclusive
+// cycles: entry (its label with symbols), calls, inclusive and exclusive cycles with their share of
+// all the exclusive cycles, inclusive cycles per call
+void    _profile_calls(FILE* file, const stCallGraph* calls);
+
+#endif
@@ -0,0 +1,960 @@
+#ifndef __RECOMPILER_H__
+#define __RECOMPILER_H__
+
+// Included inside stCore (core.h) when CPU_RECOMPILER is defined, needs stBlock / stDecoded from the
+// block cache. The _jit_ variables are static members defined after the class
+
+/*************************************************************/
+/*************************************************************/
+/********************* X86-64 RECOMPILER *********************/
+/*************************************************************/
+/*************************************************************/
+// Blocks that ran CPU_RECOMPILE_THRESHOLD times without being invalidated are translated into
+// x86-64 code. Loads, stores, ALU, compares, shifts, INC / DEC, transfers, flags, PHA / PLA,
+// branches, JMP, JSR and RTS are generated inline on the register file in stCPU. RAM / ROM operands
+// with a known page are resolved to host addresses when the block is translated (mapping memory
+// flushes the cache), (zp),Y looks the page up at runtime. Everything else calls the decoded handler
+// of the interpreter, as does an instruction the generated code cannot finish on its own: a pointer
+// to an I/O page, ADC / SBC in decimal mode, a write to a page holding cached code. Cycles and End
+// are checked after every instruction as in the block cache, flags, bus accesses and timing are
+// the ones of the interpreter.
+//
+// The arena is never writable and executable at the same time: it is mapped read / write and the
+// pages of a block are switched to read / execute once it is written (MAP_JIT on macOS).
+//
+// Generated code (System V ABI, rbx = stCPU*, r12 = &_cpu_code_writes, also the base the other core
+// globals are addressed from, r13d = _cpu_code_writes on entry)
+//
+//  entry:      push rbx / push r12 / push r13 / mov rbx, rdi / mov r12, &writes / mov r13d, [r12]
+//  native:     instruction on [rbx + A / X / Y / SP / P], add [rbx + Cycles], cycles
+//  handler:    mov [rbx + PC], pc / mov [rbx + LastOpCode], op / call handler(rbx, operand)
+//              add [rbx + Cycles], cycles / cmp [r12], r13d / jne exit
+//  each:       mov rax, [rbx + Cycles] / cmp rax, [End] / jae exit
+//  end:        (mov [rbx + PC], next) / mov [rbx + LastOpCode], op / mov eax, count
+//              pop r13 / pop r12 / pop rbx / ret
+//  fallback:   handler of the instruction, back to its End check
+//  exit:       mov [rbx + PC], next / mov [rbx + LastOpCode], op / mov eax, instr + 1 / jmp epilogue
+//
+// The native block returns the number of instructions it executed
+
+#define JIT_MAX_INSTR_SIZE          384
+#define JIT_MAX_BLOCK_SIZE          (64 + CPU_BLOCK_MAX * JIT_MAX_INSTR_SIZE)
+#define JIT_MAX_FIXES               (CPU_BLOCK_MAX * 4)
+
+#ifdef __APPLE__
+#define JIT_MAP_FLAGS               (MAP_PRIVATE | MAP_ANONYMOUS | MAP_JIT)
+#else
+#define JIT_MAP_FLAGS               (MAP_PRIVATE | MAP_ANONYMOUS)
+#endif
+
+// Host registers
+#define JIT_RAX                     0
+#define JIT_RCX                     1
+#define JIT_RDX                     2
+#define JIT_RBX                     3
+#define JIT_RSI                     6
+#define JIT_RDI                     7
+#define JIT_R8                      8
+#define JIT_R12                     12
+#define JIT_R13                     13
+
+// Conditions of jcc / setcc
+#define JIT_CC_AE                   0x3
+#define JIT_CC_E                    0x4
+#define JIT_CC_NE                   0x5
+#define JIT_CC_BE                   0x6
+#define JIT_CC_ALWAYS               0xFF
+
+// Out of line code an instruction jumps to
+#define JIT_STUB_FALLBACK           0
+#define JIT_STUB_EXIT               1
+
+// Offsets in stCPU, A / X / Y / SP / PC are the register macros of the core (globals.h)
+#pragma push_macro("A")
+#pragma push_macro("X")
+#pragma push_macro("Y")
+#pragma push_macro("SP")
+#pragma push_macro("PC")
+#undef A
+#undef X
+#undef Y
+#undef SP
+#undef PC
+enum {
+    JIT_CPU_A                   = offsetof(stCPU, A),
+    JIT_CPU_X                   = offsetof(stCPU, X),
+    JIT_CPU_Y                   = offsetof(stCPU, Y),
+    JIT_CPU_SP                  = offsetof(stCPU, SP),
+    JIT_CPU_PC                  = offsetof(stCPU, PC),
+    JIT_CPU_P                   = offsetof(stCPU, P),
+    JIT_CPU_OPCODE              = offsetof(stCPU, LastOpCode),
+    JIT_CPU_IDLE                = offsetof(stCPU, Idle),
+    JIT_CPU_CYCLES              = offsetof(stCPU, Cycles)
+};
+#pragma pop_macro("PC")
+#pragma pop_macro("SP")
+#pragma pop_macro("Y")
+#pragma pop_macro("X")
+#pragma pop_macro("A")
+
+// Handlers and addressing modes of opcodes.h
+enum {
+    JIT_ADC, JIT_AHX, JIT_ALR, JIT_ANC, JIT_AND, JIT_ARR, JIT_ASL, JIT_AXS, JIT_BCC, JIT_BCS, JIT_BEQ,
+    JIT_BIT, JIT_BMI, JIT_BNE, JIT_BPL, JIT_BRK, JIT_BVC, JIT_BVS, JIT_CLC, JIT_CLD, JIT_CLI, JIT_CLV,
+    JIT_CMP, JIT_CPX, JIT_CPY, JIT_DCP, JIT_DEC, JIT_DEX, JIT_DEY, JIT_EOR, JIT_INC, JIT_INX, JIT_INY,
+    JIT_ISC, JIT_JMP, JIT_JSR, JIT_KIL, JIT_LAS, JIT_LAX, JIT_LDA, JIT_LDX, JIT_LDY, JIT_LSR, JIT_NOP,
+    JIT_ORA, JIT_PHA, JIT_PHP, JIT_PLA, JIT_PLP, JIT_RLA, JIT_ROL, JIT_ROR, JIT_RRA, JIT_RTI, JIT_RTS,
+    JIT_SAX, JIT_SBC, JIT_SEC, JIT_SED, JIT_SEI, JIT_SHX, JIT_SHY, JIT_SLO, JIT_SRE, JIT_STA, JIT_STX,
+    JIT_STY, JIT_TAS, JIT_TAX, JIT_TAY, JIT_TSX, JIT_TXA, JIT_TXS, JIT_TYA, JIT_XAA
+};
+
+enum {
+    JIT_ADDR_ABSOLUTE, JIT_ADDR_ABSOLUTE_X, JIT_ADDR_ABSOLUTE_Y, JIT_ADDR_ACCUMULATOR, JIT_ADDR_IMMEDIATE,
+    JIT_ADDR_IMPLIED, JIT_ADDR_INDIRECT_X, JIT_ADDR_INDIRECT, JIT_ADDR_INDIRECT_Y, JIT_ADDR_RELATIVE,
+    JIT_ADDR_ZEROPAGE, JIT_ADDR_ZEROPAGE_X, JIT_ADDR_ZEROPAGE_Y
+};
+
+typedef struct {
+    u8 Op;                          // JIT_ handler
+    u8 Mode;                        // JIT_ADDR_
+    u8 PageCycles;
+} stJitInfo;
+
+typedef struct {
+    u8* At;                         // rel32 to patch
+    u8 Stub;                        // JIT_STUB_
+    u8 Instr;
+} stJitFix;
+
+static u8*      _jit_arena;
+static u32      _jit_used;
+static bool     _jit_disabled;
+static u8*      _jit_pos;
+static stJitFix _jit_fixes[JIT_MAX_FIXES];
+static u32      _jit_fix_count;
+
+/*************************************************************/
+/*************************************************************/
+/************************* EMITTER ***************************/
+/*************************************************************/
+/*************************************************************/
+static inline void _jit_u8(u8 v)    { *_jit_pos++ = v; }
+static inline void _jit_u16(u16 v)  { _jit_u8((u8)v); _jit_u8((u8)(v >> 8)); }
+static inline void _jit_u32(u32 v)  { for (int i = 0; i < 4; ++i) { _jit_u8((u8)(v >> (i * 8))); } }
+static inline void _jit_u64(u64 v)  { for (int i = 0; i < 8; ++i) { _jit_u8((u8)(v >> (i * 8))); } }
+
+// Displacement of a core global from r12
+static inline i32 _jit_global(const void* at) {
+    return (i32)((const u8*)at - (const u8*)&_cpu_code_writes);
+}
+
+// REX prefix when needed, then the opcode (0x0Fxx for the two byte ones)
+static void _jit_opcode(u8 w, u8 reg, u8 index, u8 rm, u16 op) {
+    u8 rex = 0x40 | (w << 3) | ((reg & 8) >> 1) | ((index & 8) >> 2) | ((rm & 8) >> 3);
+    if (rex != 0x40) {
+        _jit_u8(rex);
+    }
+    if (op > 0xFF) {
+        _jit_u8((u8)(op >> 8));
+    }
+    _jit_u8((u8)op);
+}
+
+// op reg, rm (reg is the /digit of the group opcodes). Byte registers are only al / cl / dl
+static void _jit_reg(u16 op, u8 w, u8 reg, u8 rm) {
+    _jit_opcode(w, reg, 0, rm, op);
+    _jit_u8(0xC0 | ((reg & 7) << 3) | (rm & 7));
+}
+
+// op reg, [base + disp]
+static void _jit_mem(u16 op, u8 w, u8 reg, u8 base, i32 disp) {
+    _jit_opcode(w, reg, 0, base, op);
+    _jit_u8(0x80 | ((reg & 7) << 3) | (base & 7));
+    if ((base & 7) == 4) {
+        _jit_u8(0x24);              // SIB of r12
+    }
+    _jit_u32((u32)disp);
+}
+
+// op reg, [base + index + disp]
+static void _jit_index(u16 op, u8 w, u8 reg, u8 base, u8 index, i32 disp) {
+    _jit_opcode(w, reg, index, base, op);
+    _jit_u8(0x84 | ((reg & 7) << 3));
+    _jit_u8(((index & 7) << 3) | (base & 7));
+    _jit_u32((u32)disp);
+}
+
+static void _jit_mov32(u8 reg, u32 v) {
+    _jit_opcode(0, 0, 0, reg, 0xB8 + (reg & 7));
+    _jit_u32(v);
+}
+
+static void _jit_mov64(u8 reg, u64 v) {
+    _jit_opcode(1, 0, 0, reg, 0xB8 + (reg & 7));
+    _jit_u64(v);
+}
+
+// Short forward jumps, resolved by _jit_here
+static u8* _jit_jcc8(u8 cc) {
+    _jit_u8(cc == JIT_CC_ALWAYS ? 0xEB : 0x70 | cc);
+    _jit_u8(0);
+    return _jit_pos - 1;
+}
+
+static void _jit_here(u8* at) {
+    *at = (u8)(_jit_pos - (at + 1));
+}
+
+static void _jit_patch(u8* at, const u8* target) {
+    u32 rel = (u32)(target - (at + 4));
+    memcpy(at, &rel, 4);
+}
+
+static void _jit_jmp(const u8* target) {
+    _jit_u8(0xE9);
+    _jit_u32(0);
+    _jit_patch(_jit_pos - 4, target);
+}
+
+// Jump to the fallback / exit of an instruction, patched once the stubs are written
+static void _jit_stub(u8 cc, u8 stub, u8 instr) {
+    if (cc == JIT_CC_ALWAYS) {
+        _jit_u8(0xE9);
+    }
+    else {
+        _jit_u8(0x0F);
+        _jit_u8(0x80 | cc);
+    }
+    stJitFix& fix = _jit_fixes[_jit_fix_count++];
+    fix.At = _jit_pos;
+    fix.Stub = stub;
+    fix.Instr = instr;
+    _jit_u32(0);
+}
+
+/*************************************************************/
+/*************************************************************/
+/************************ GUEST STATE ************************/
+/*************************************************************/
+/*************************************************************/
+static void _jit_cycles(u8 cycles) {
+    if (cycles) {
+        _jit_mem(0x83, 1, 0, JIT_RBX, JIT_CPU_CYCLES);             // add qword [rbx + Cycles], cycles
+        _jit_u8(cycles);
+    }
+}
+
+static void _jit_pc(u16 pc) {
+    _jit_u8(0x66);
+    _jit_mem(0xC7, 0, 0, JIT_RBX, JIT_CPU_PC);                     // mov word [rbx + PC], pc
+    _jit_u16(pc);
+}
+
+static void _jit_lastOpCode(u8 opcode) {
+    _jit_mem(0xC6, 0, 0, JIT_RBX, JIT_CPU_OPCODE);                 // mov byte [rbx + LastOpCode], opcode
+    _jit_u8(opcode);
+}
+
+// P = (P & ~mask) | NZ[eax], | ecx too with bits
+static void _jit_flags(u8 mask, bool bits) {
+    _jit_index(0x0FB6, 0, JIT_RDX, JIT_R12, JIT_RAX, _jit_global(_cpu_tables.NZ));  // movzx edx, byte [NZ + rax]
+    if (bits) {
+        _jit_reg(0x0B, 0, JIT_RDX, JIT_RCX);                        // or edx, ecx
+    }
+    _jit_mem(0x80, 0, 4, JIT_RBX, JIT_CPU_P);                      // and byte [rbx + P], ~mask
+    _jit_u8((u8)~mask);
+    _jit_mem(0x08, 0, JIT_RDX, JIT_RBX, JIT_CPU_P);                // or [rbx + P], dl
+}
+
+// [rdx] = al, marks the iteration busy when the byte changes as _cpu_mem_write does
+static void _jit_store() {
+#ifdef CPU_IDLE_DETECT
+    _jit_mem(0x38, 0, JIT_RAX, JIT_RDX, 0);                        // cmp [rdx], al
+    u8* same = _jit_jcc8(JIT_CC_E);
+    _jit_mem(0x80, 0, 1, JIT_RBX, JIT_CPU_IDLE);                   // or byte [rbx + Idle], CPU_IDLE_BUSY
+    _jit_u8(CPU_IDLE_BUSY);
+    _jit_here(same);
+#endif
+    _jit_mem(0x88, 0, JIT_RAX, JIT_RDX, 0);                        // mov [rdx], al
+}
+
+// A write to a page holding cached code goes through the handler (_cpu_block_write)
+static void _jit_codePage(u8 page, u8 instr) {
+    _jit_mem(0x80, 0, 7, JIT_R12, _jit_global(&_cpu_code_page[page]));  // cmp byte [code page], 0
+    _jit_u8(0);
+    _jit_stub(JIT_CC_NE, JIT_STUB_FALLBACK, instr);
+}
+
+// RAM or ROM behind addr, RAM only for a write. NULL for I/O and unmapped pages
+static u8* _jit_host(u16 addr, bool write) {
+    const stPage& page = _cpu_pages[addr >> 8];
+    if (!page.Read || (write && page.Write != page.Read)) {
+        return NULL;
+    }
+    return (u8*)page.Read + (addr & 0xFF);
+}
+
+// Zero page and stack page as ZP_READ / ZP_WRITE see them
+static u8* _jit_zp(u16 addr, bool write) {
+#ifdef CPU_ZP_STACK_RAM
+    if (_cpu_zp_stack) {
+        return _cpu_zp_stack + addr;
+    }
+#endif
+    return _jit_host(addr, write);
+}
+
+// Host address of the operand in rdx, false when it cannot be generated (I/O or unmapped page, mode
+// left to the handler). The fallback is taken for what only the run can tell, page crossing cycles are
+// added once nothing can fall back anymore
+static bool _jit_operand(const stDecoded& instr, const stJitInfo& info, bool write, u8 index) {
+    u16 operand = instr.Operand;
+    switch (info.Mode) {
+        case JIT_ADDR_ZEROPAGE:
+        case JIT_ADDR_ZEROPAGE_X:
+        case JIT_ADDR_ZEROPAGE_Y: {
+            u8* mem = _jit_zp(0, write);
+            if (!mem) {
+                return false;
+            }
+            if (write) {
+                _jit_codePage(0, index);
+            }
+            if (info.Mode == JIT_ADDR_ZEROPAGE) {
+                _jit_mov64(JIT_RDX, (u64)(mem + operand));
+                return true;
+            }
+            _jit_mem(0x0FB6, 0, JIT_RCX, JIT_RBX, info.Mode == JIT_ADDR_ZEROPAGE_X ? JIT_CPU_X : JIT_CPU_Y);
+            _jit_reg(0x81, 0, 0, JIT_RCX);                          // add ecx, operand
+            _jit_u32(operand);
+            _jit_reg(0x0FB6, 0, JIT_RCX, JIT_RCX);                  // movzx ecx, cl
+            _jit_mov64(JIT_RDX, (u64)mem);
+            _jit_reg(0x01, 1, JIT_RCX, JIT_RDX);                    // add rdx, rcx
+            return true;
+        }
+        case JIT_ADDR_ABSOLUTE: {
+            u8* mem = _jit_host(operand, write);
+            if (!mem) {
+                return false;
+            }
+            if (write) {
+                _jit_codePage(operand >> 8, index);
+            }
+            _jit_mov64(JIT_RDX, (u64)mem);
+            return true;
+        }
+        case JIT_ADDR_ABSOLUTE_X:
+        case JIT_ADDR_ABSOLUTE_Y: {
+            // The two pages the index can reach have to be one block of host memory
+            u8* mem = _jit_host(operand, write);
+            u8 lo = operand & 0xFF;
+            if (!mem || (lo && ((operand >> 8) == 0xFF || _jit_host((u16)(operand - lo + 0x100), write) != mem - lo + 0x100))) {
+                return false;
+            }
+            _jit_mem(0x0FB6, 0, JIT_RCX, JIT_RBX, info.Mode == JIT_ADDR_ABSOLUTE_X ? JIT_CPU_X : JIT_CPU_Y);
+            if (write && !lo) {
+                _jit_codePage(operand >> 8, index);
+            }
+            else if (write) {
+                _jit_reg(0x8B, 0, JIT_RAX, JIT_RCX);                // mov eax, ecx
+                _jit_reg(0x81, 0, 0, JIT_RAX);                      // add eax, operand
+                _jit_u32(operand);
+                _jit_reg(0xC1, 0, 5, JIT_RAX);                      // shr eax, 8
+                _jit_u8(8);
+                _jit_index(0x80, 0, 7, JIT_R12, JIT_RAX, _jit_global(_cpu_code_page));  // cmp byte [code page + rax], 0
+                _jit_u8(0);
+                _jit_stub(JIT_CC_NE, JIT_STUB_FALLBACK, index);
+            }
+            if (info.PageCycles && lo) {
+                _jit_reg(0x81, 0, 7, JIT_RCX);                      // cmp ecx, 0xFF - lo
+                _jit_u32(0xFF - lo);
+                u8* same = _jit_jcc8(JIT_CC_BE);
+                _jit_cycles(info.PageCycles);
+                _jit_here(same);
+            }
+            _jit_mov64(JIT_RDX, (u64)mem);
+            _jit_reg(0x01, 1, JIT_RCX, JIT_RDX);                    // add rdx, rcx
+            return true;
+        }
+        case JIT_ADDR_INDIRECT_Y: {
+            u8* mem = _jit_zp(0, false);
+            if (!mem) {
+                return false;
+            }
+            _jit_mov64(JIT_RDX, (u64)mem);
+            _jit_mem(0x0FB6, 0, JIT_RCX, JIT_RDX, operand);         // movzx ecx, byte [zp + operand]
+            _jit_mem(0x0FB6, 0, JIT_RDX, JIT_RDX, (operand + 1) & 0xFF);
+            _jit_reg(0xC1, 0, 4, JIT_RDX);                          // shl edx, 8
+            _jit_u8(8);
+            _jit_reg(0x0B, 0, JIT_RCX, JIT_RDX);                    // or ecx, edx          (base)
+            _jit_mem(0x0FB6, 0, JIT_RAX, JIT_RBX, JIT_CPU_Y);
+            _jit_reg(0x03, 0, JIT_RAX, JIT_RCX);                    // add eax, ecx
+            _jit_reg(0x0FB7, 0, JIT_RAX, JIT_RAX);                  // movzx eax, ax        (address)
+            _jit_reg(0x8B, 0, JIT_R8, JIT_RAX);                     // mov r8d, eax
+            _jit_reg(0xC1, 0, 5, JIT_R8);                           // shr r8d, 8
+            _jit_u8(8);
+            if (write) {
+                _jit_index(0x80, 0, 7, JIT_R12, JIT_R8, _jit_global(_cpu_code_page));  // cmp byte [code page + r8], 0
+                _jit_u8(0);
+                _jit_stub(JIT_CC_NE, JIT_STUB_FALLBACK, index);
+            }
+            _jit_reg(0x6B, 0, JIT_R8, JIT_R8);                      // imul r8d, r8d, sizeof(stPage)
+            _jit_u8(sizeof(stPage));
+            _jit_index(0x8B, 1, JIT_RDX, JIT_R12, JIT_R8, _jit_global(write ? (const void*)&_cpu_pages[0].Write : (const void*)&_cpu_pages[0].Read));
+            _jit_reg(0x85, 1, JIT_RDX, JIT_RDX);                    // test rdx, rdx        (I/O page)
+            _jit_stub(JIT_CC_E, JIT_STUB_FALLBACK, index);
+            if (info.PageCycles) {
+                _jit_reg(0x33, 0, JIT_RCX, JIT_RAX);                // xor ecx, eax
+                _jit_reg(0xF7, 0, 0, JIT_RCX);                      // test ecx, 0xFF00
+                _jit_u32(0xFF00);
+                u8* same = _jit_jcc8(JIT_CC_E);
+                _jit_cycles(info.PageCycles);
+                _jit_here(same);
+            }
+            _jit_reg(0x0FB6, 0, JIT_RAX, JIT_RAX);                  // movzx eax, al
+            _jit_reg(0x01, 1, JIT_RAX, JIT_RDX);                    // add rdx, rax
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// Operand value in eax (zero extended)
+static bool _jit_value(const stDecoded& instr, const stJitInfo& info, u8 index) {
+    if (info.Mode == JIT_ADDR_IMMEDIATE) {
+        _jit_mov32(JIT_RAX, instr.Operand);
+        return true;
+    }
+    if (!_jit_operand(instr, info, false, index)) {
+        return false;
+    }
+    _jit_mem(0x0FB6, 0, JIT_RAX, JIT_RDX, 0);
+    return true;
+}
+
+// rdx = host address of the stack byte at SP
+static bool _jit_stack() {
+    u8* mem = _jit_zp(0x100, true);
+    if (!mem) {
+        return false;
+    }
+    _jit_mem(0x0FB6, 0, JIT_RCX, JIT_RBX, JIT_CPU_SP);
+    _jit_mov64(JIT_RDX, (u64)mem);
+    _jit_reg(0x01, 1, JIT_RCX, JIT_RDX);                            // add rdx, rcx
+    return true;
+}
+
+// Pushes al, the page check is done by the caller
+static void _jit_push() {
+    _jit_stack();
+    _jit_store();
+    _jit_mem(0x80, 0, 5, JIT_RBX, JIT_CPU_SP);                     // sub byte [rbx + SP], 1
+    _jit_u8(1);
+}
+
+static void _jit_pull() {
+    _jit_mem(0x80, 0, 0, JIT_RBX, JIT_CPU_SP);                     // add byte [rbx + SP], 1
+    _jit_u8(1);
+    _jit_stack();
+    _jit_mem(0x0FB6, 0, JIT_RAX, JIT_RDX, 0);
+}
+
+#ifdef CPU_IDLE_DETECT
+static void _jit_idle(stCPU* state, u16 addr) {
+    stCPU& cpu = *state;
+    _cpu_idleBranch(CPU_ARG, addr);
+}
+#endif
+
+/*************************************************************/
+/*************************************************************/
+/*********************** INSTRUCTIONS ************************/
+/*************************************************************/
+/*************************************************************/
+static u8 _jit_register(u8 op) {
+    switch (op) {
+        case JIT_LDX: case JIT_STX: case JIT_CPX: case JIT_INX: case JIT_DEX: case JIT_TXA: case JIT_TXS:
+            return JIT_CPU_X;
+        case JIT_LDY: case JIT_STY: case JIT_CPY: case JIT_INY: case JIT_DEY: case JIT_TYA:
+            return JIT_CPU_Y;
+        default:
+            return JIT_CPU_A;
+    }
+}
+
+// Generates the instruction at pc, false (nothing emitted) to leave it to its handler. flow is set
+// when the instruction stored PC itself
+static bool _jit_native(const stDecoded& instr, const stJitInfo& info, u16 pc, u8 index, bool& flow) {
+    u8 reg = _jit_register(info.Op);
+    switch (info.Op) {
+        case JIT_LDA:
+        case JIT_LDX:
+        case JIT_LDY:
+            if (!_jit_value(instr, info, index)) {
+                return false;
+            }
+            _jit_mem(0x88, 0, JIT_RAX, JIT_RBX, reg);               // mov [rbx + reg], al
+            _jit_flags(FLAG_N | FLAG_Z, false);
+            break;
+
+        case JIT_STA:
+        case JIT_STX:
+        case JIT_STY:
+            if (!_jit_operand(instr, info, true, index)) {
+                return false;
+            }
+            _jit_mem(0x0FB6, 0, JIT_RAX, JIT_RBX, reg);
+            _jit_store();
+            break;
+
+        case JIT_AND:
+        case JIT_ORA:
+        case JIT_EOR:
+            if (!_jit_value(instr, info, index)) {
+                return false;
+            }
+            _jit_mem(info.Op == JIT_AND ? 0x22 : info.Op == JIT_ORA ? 0x0A : 0x32, 0, JIT_RAX, JIT_RBX, JIT_CPU_A);  // op al, [rbx + A]
+            _jit_mem(0x88, 0, JIT_RAX, JIT_RBX, JIT_CPU_A);
+            _jit_flags(FLAG_N | FLAG_Z, false);
+            break;
+
+        case JIT_CMP:
+        case JIT_CPX:
+        case JIT_CPY:
+            if (!_jit_value(instr, info, index)) {
+                return false;
+            }
+            _jit_mem(0x0FB6, 0, JIT_RCX, JIT_RBX, reg);
+            _jit_reg(0x2B, 0, JIT_RCX, JIT_RAX);                    // sub ecx, eax
+            _jit_reg(0x0F93, 0, 0, JIT_RAX);                        // setae al             (C)
+            _jit_u8(0x91);                                          // xchg eax, ecx
+            _jit_reg(0x0FB6, 0, JIT_RAX, JIT_RAX);                  // movzx eax, al
+            _jit_flags(FLAG_N | FLAG_Z | FLAG_C, true);
+            break;
+
+        case JIT_BIT:
+            if (!_jit_value(instr, info, index)) {
+                return false;
+            }
+            _jit_reg(0x8B, 0, JIT_RCX, JIT_RAX);                    // mov ecx, eax
+            _jit_reg(0x81, 0, 4, JIT_RCX);                          // and ecx, N | V
+            _jit_u32(FLAG_N | FLAG_V);
+            _jit_mem(0x84, 0, JIT_RAX, JIT_RBX, JIT_CPU_A);         // test [rbx + A], al
+            _jit_reg(0x0F94, 0, 0, JIT_RAX);                        // sete al
+            _jit_reg(0x0FB6, 0, JIT_RAX, JIT_RAX);
+            _jit_reg(0x01, 0, JIT_RAX, JIT_RAX);                    // add eax, eax         (Z)
+            _jit_reg(0x0B, 0, JIT_RCX, JIT_RAX);                    // or ecx, eax
+            _jit_mem(0x80, 0, 4, JIT_RBX, JIT_CPU_P);
+            _jit_u8((u8)~(FLAG_N | FLAG_V | FLAG_Z));
+            _jit_mem(0x08, 0, JIT_RCX, JIT_RBX, JIT_CPU_P);         // or [rbx + P], cl
+            break;
+
+        case JIT_ADC:
+        case JIT_SBC:
+            _jit_mem(0xF6, 0, 0, JIT_RBX, JIT_CPU_P);               // test byte [rbx + P], D
+            _jit_u8(FLAG_D);
+            _jit_stub(JIT_CC_NE, JIT_STUB_FALLBACK, index);
+            if (!_jit_value(instr, info, index)) {
+                return false;
+            }
+            if (info.Op == JIT_SBC) {
+                _jit_reg(0x81, 0, 6, JIT_RAX);                      // xor eax, 0xFF
+                _jit_u32(0xFF);
+            }
+            _jit_mem(0x0FB6, 0, JIT_RCX, JIT_RBX, JIT_CPU_A);
+            _jit_mem(0x0FB6, 0, JIT_RDX, JIT_RBX, JIT_CPU_P);
+            _jit_reg(0x81, 0, 4, JIT_RDX);                          // and edx, C
+            _jit_u32(FLAG_C);
+            _jit_reg(0x03, 0, JIT_RDX, JIT_RAX);
+            _jit_reg(0x03, 0, JIT_RDX, JIT_RCX);                    // edx = A + val + C
+            _jit_reg(0x33, 0, JIT_RAX, JIT_RCX);
+            _jit_reg(0xF7, 0, 2, JIT_RAX);                          // eax = ~(A ^ val)
+            _jit_reg(0x33, 0, JIT_RCX, JIT_RDX);                    // ecx = A ^ sum
+            _jit_reg(0x23, 0, JIT_RCX, JIT_RAX);
+            _jit_reg(0x81, 0, 4, JIT_RCX);
+            _jit_u32(0x80);
+            _jit_reg(0xC1, 0, 5, JIT_RCX);                          // ecx = V
+            _jit_u8(1);
+            _jit_reg(0x8B, 0, JIT_RAX, JIT_RDX);
+            _jit_reg(0xC1, 0, 5, JIT_RDX);                          // edx = C
+            _jit_u8(8);
+            _jit_reg(0x0B, 0, JIT_RCX, JIT_RDX);
+            _jit_reg(0x0FB6, 0, JIT_RAX, JIT_RAX);
+            _jit_mem(0x88, 0, JIT_RAX, JIT_RBX, JIT_CPU_A);
+            _jit_flags(FLAG_N | FLAG_V | FLAG_Z | FLAG_C, true);
+            break;
+
+        case JIT_INC:
+        case JIT_DEC:
+            if (!_jit_operand(instr, info, true, index)) {
+                return false;
+            }
+            _jit_mem(0x0FB6, 0, JIT_RAX, JIT_RDX, 0);
+            _jit_reg(0x80, 0, info.Op == JIT_INC ? 0 : 5, JIT_RAX); // add / sub al, 1
+            _jit_u8(1);
+            _jit_store();
+            _jit_flags(FLAG_N | FLAG_Z, false);
+            break;
+
+        case JIT_INX:
+        case JIT_INY:
+        case JIT_DEX:
+        case JIT_DEY:
+            _jit_mem(0x0FB6, 0, JIT_RAX, JIT_RBX, reg);
+            _jit_reg(0x80, 0, info.Op == JIT_INX || info.Op == JIT_INY ? 0 : 5, JIT_RAX);
+            _jit_u8(1);
+            _jit_mem(0x88, 0, JIT_RAX, JIT_RBX, reg);
+            _jit_flags(FLAG_N | FLAG_Z, false);
+            break;
+
+        case JIT_ASL:
+        case JIT_LSR:
+        case JIT_ROL:
+        case JIT_ROR:
+            if (info.Mode == JIT_ADDR_ACCUMULATOR) {
+                _jit_mem(0x0FB6, 0, JIT_RAX, JIT_RBX, JIT_CPU_A);
+            }
+            else if (_jit_operand(instr, info, true, index)) {
+                _jit_mem(0x0FB6, 0, JIT_RAX, JIT_RDX, 0);
+            }
+            else {
+                return false;
+            }
+            if (info.Op == JIT_ROL || info.Op == JIT_ROR) {
+                _jit_mem(0x0FB6, 0, JIT_R8, JIT_RBX, JIT_CPU_P);
+                _jit_reg(0x81, 0, 4, JIT_R8);                       // r8d = C
+                _jit_u32(FLAG_C);
+            }
+            _jit_reg(0x8B, 0, JIT_RCX, JIT_RAX);                    // mov ecx, eax
+            if (info.Op == JIT_ASL || info.Op == JIT_ROL) {
+                _jit_reg(0xC1, 0, 5, JIT_RCX);                      // ecx = bit 7
+                _jit_u8(7);
+                _jit_reg(0xC1, 0, 4, JIT_RAX);                      // shl eax, 1
+                _jit_u8(1);
+            }
+            else {
+                _jit_reg(0x81, 0, 4, JIT_RCX);                      // ecx = bit 0
+                _jit_u32(1);
+                _jit_reg(0xC1, 0, 5, JIT_RAX);                      // shr eax, 1
+                _jit_u8(1);
+                if (info.Op == JIT_ROR) {
+                    _jit_reg(0xC1, 0, 4, JIT_R8);                   // shl r8d, 7
+                    _jit_u8(7);
+                }
+            }
+            if (info.Op == JIT_ROL || info.Op == JIT_ROR) {
+                _jit_reg(0x0B, 0, JIT_RAX, JIT_R8);                 // or eax, r8d
+            }
+            _jit_reg(0x0FB6, 0, JIT_RAX, JIT_RAX);
+            if (info.Mode == JIT_ADDR_ACCUMULATOR) {
+                _jit_mem(0x88, 0, JIT_RAX, JIT_RBX, JIT_CPU_A);
+            }
+            else {
+                _jit_store();
+            }
+            _jit_flags(FLAG_N | FLAG_Z | FLAG_C, true);
+            break;
+
+        case JIT_TAX:
+        case JIT_TAY:
+        case JIT_TXA:
+        case JIT_TYA:
+        case JIT_TSX:
+        case JIT_TXS: {
+            u8 from = info.Op == JIT_TSX ? (u8)JIT_CPU_SP : info.Op == JIT_TAX || info.Op == JIT_TAY ? (u8)JIT_CPU_A : reg;
+            u8 to = info.Op == JIT_TXS ? JIT_CPU_SP : info.Op == JIT_TAX || info.Op == JIT_TSX ? JIT_CPU_X :
+                    info.Op == JIT_TAY ? JIT_CPU_Y : JIT_CPU_A;
+            _jit_mem(0x0FB6, 0, JIT_RAX, JIT_RBX, from);
+            _jit_mem(0x88, 0, JIT_RAX, JIT_RBX, to);
+            if (info.Op != JIT_TXS) {
+                _jit_flags(FLAG_N | FLAG_Z, false);
+            }
+            break;
+        }
+
+        case JIT_CLC:
+        case JIT_CLD:
+        case JIT_CLV:
+            _jit_mem(0x80, 0, 4, JIT_RBX, JIT_CPU_P);               // and byte [rbx + P], ~flag
+            _jit_u8((u8)~(info.Op == JIT_CLC ? FLAG_C : info.Op == JIT_CLD ? FLAG_D : FLAG_V));
+            break;
+
+        case JIT_SEC:
+        case JIT_SED:
+        case JIT_SEI:
+            _jit_mem(0x80, 0, 1, JIT_RBX, JIT_CPU_P);               // or byte [rbx + P], flag
+            _jit_u8(info.Op == JIT_SEC ? FLAG_C : info.Op == JIT_SED ? FLAG_D : FLAG_I);
+            break;
+
+        case JIT_NOP:
+            // Nothing read, only the indexed ones can take a page crossing cycle
+            if (info.PageCycles) {
+                return false;
+            }
+            break;
+
+        case JIT_PHA:
+            if (!_jit_zp(0x100, true)) {
+                return false;
+            }
+            _jit_codePage(1, index);
+            _jit_mem(0x0FB6, 0, JIT_RAX, JIT_RBX, JIT_CPU_A);
+            _jit_push();
+            break;
+
+        case JIT_PLA:
+            if (!_jit_zp(0x100, true)) {
+                return false;
+            }
+            _jit_pull();
+            _jit_mem(0x88, 0, JIT_RAX, JIT_RBX, JIT_CPU_A);
+            _jit_flags(FLAG_N | FLAG_Z, false);
+            break;
+
+        case JIT_BPL:
+        case JIT_BMI:
+        case JIT_BVC:
+        case JIT_BVS:
+        case JIT_BCC:
+        case JIT_BCS:
+        case JIT_BNE:
+        case JIT_BEQ: {
+            u8 flag = info.Op == JIT_BPL || info.Op == JIT_BMI ? FLAG_N : info.Op == JIT_BVC || info.Op == JIT_BVS ? FLAG_V :
+                      info.Op == JIT_BCC || info.Op == JIT_BCS ? FLAG_C : FLAG_Z;
+            bool set = info.Op == JIT_BMI || info.Op == JIT_BVS || info.Op == JIT_BCS || info.Op == JIT_BEQ;
+            u16 next = (u16)(pc + 2);
+            _jit_mem(0xF6, 0, 0, JIT_RBX, JIT_CPU_P);               // test byte [rbx + P], flag
+            _jit_u8(flag);
+            u8* skip = _jit_jcc8(set ? JIT_CC_E : JIT_CC_NE);
+            _jit_cycles(1 + PAGE_DIFFER(next, instr.Operand));
+#ifdef CPU_IDLE_DETECT
+            if (instr.Operand < next) {
+                _jit_pc(next);
+                _jit_reg(0x89, 1, JIT_RBX, JIT_RDI);                // _jit_idle(cpu, target)
+                _jit_mov32(JIT_RSI, instr.Operand);
+                _jit_mov64(JIT_RAX, (u64)&_jit_idle);
+                _jit_reg(0xFF, 0, 2, JIT_RAX);
+            }
+#endif
+            _jit_pc(instr.Operand);
+            u8* done = _jit_jcc8(JIT_CC_ALWAYS);
+            _jit_here(skip);
+            _jit_pc(next);
+            _jit_here(done);
+            flow = true;
+            break;
+        }
+
+        case JIT_JMP:
+            if (info.Mode != JIT_ADDR_ABSOLUTE) {
+                return false;
+            }
+            _jit_pc(instr.Operand);
+            flow = true;
+            break;
+
+#ifndef CPU_CALLGRAPH
+        case JIT_JSR:
+            if (!_jit_zp(0x100, true)) {
+                return false;
+            }
+            _jit_codePage(1, index);
+            _jit_mov32(JIT_RAX, (u16)(pc + 2) >> 8);
+            _jit_push();
+            _jit_mov32(JIT_RAX, (u16)(pc + 2) & 0xFF);
+            _jit_push();
+            _jit_pc(instr.Operand);
+            flow = true;
+            break;
+
+        case JIT_RTS:
+            if (!_jit_zp(0x100, true)) {
+                return false;
+            }
+            _jit_pull();
+            _jit_reg(0x8B, 0, JIT_R8, JIT_RAX);                     // mov r8d, eax         (low byte)
+            _jit_pull();
+            _jit_reg(0xC1, 0, 4, JIT_RAX);                          // shl eax, 8
+            _jit_u8(8);
+            _jit_reg(0x0B, 0, JIT_RAX, JIT_R8);
+            _jit_reg(0x81, 0, 0, JIT_RAX);                          // add eax, 1
+            _jit_u32(1);
+            _jit_u8(0x66);
+            _jit_mem(0x89, 0, JIT_RAX, JIT_RBX, JIT_CPU_PC);        // mov [rbx + PC], ax
+            flow = true;
+            break;
+#endif
+
+        default:
+            return false;
+    }
+    _jit_cycles(instr.Cycles);
+    return true;
+}
+
+// Handler of the interpreter for the instruction at pc
+static void _jit_call(const stDecoded& instr, u16 pc) {
+    _jit_pc(pc);
+    _jit_lastOpCode(instr.OpCode);
+    _jit_reg(0x89, 1, JIT_RBX, JIT_RDI);                            // mov rdi, rbx
+    _jit_mov32(JIT_RSI, instr.Operand);
+    _jit_mov64(JIT_RAX, (u64)instr.Handler);
+    _jit_reg(0xFF, 0, 2, JIT_RAX);                                  // call rax
+    _jit_cycles(instr.Cycles);
+}
+
+// Leaves after the instruction when it wrote to cached code
+static void _jit_writes(u8 index) {
+    _jit_mem(0x8B, 0, JIT_RAX, JIT_R12, 0);                        // mov eax, [r12]
+    _jit_reg(0x39, 0, JIT_R13, JIT_RAX);                            // cmp eax, r13d
+    _jit_stub(JIT_CC_NE, JIT_STUB_EXIT, index);
+}
+
+/*************************************************************/
+/*************************************************************/
+/************************** ARENA ****************************/
+/*************************************************************/
+/*************************************************************/
+static bool _jit_protect(u8* from, u32 size, int prot) {
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t first = (uintptr_t)from & ~(page - 1);
+    uintptr_t last = ((uintptr_t)from + size + page - 1) & ~(page - 1);
+    return mprotect((void*)first, last - first, prot) == 0;
+}
+
+// The arena, and the globals in reach of r12. false when the recompiler cannot run on this host
+static bool _jit_init() {
+    if (_jit_arena) {
+        return true;
+    }
+    const void* globals[] = { _cpu_code_page, _cpu_pages, _cpu_pages + 256, _cpu_tables.NZ, &_cpu_scheduler.End };
+    for (u32 i = 0; i < sizeof(globals) / sizeof(globals[0]); ++i) {
+        intptr_t distance = (const u8*)globals[i] - (const u8*)&_cpu_code_writes;
+        if (distance > 0x7FFF0000 || distance < -0x7FFF0000) {
+            return false;
+        }
+    }
+    void* arena = mmap(NULL, CPU_RECOMPILER_ARENA, PROT_READ | PROT_WRITE, JIT_MAP_FLAGS, -1, 0);
+    if (arena == MAP_FAILED) {
+        return false;
+    }
+    _jit_arena = (u8*)arena;
+    return true;
+}
+
+static void _jit_flush() {
+    _jit_used = 0;
+    for (int i = 0; i < CPU_BLOCK_CACHE_SIZE; ++i) {
+        _cpu_blocks[i].Native = NULL;
+        _cpu_blocks[i].Hits = 0;
+    }
+}
+
+static fpNative _jit_compile(const stBlock& block) {
+    #define INSTR_CASE(id, mnemonic, addr_handler, size, cycles, page_cycles, handler) { JIT_##handler, JIT_##addr_handler, page_cycles },
+    static const stJitInfo _jit_info[256] = {
+        #include "opcodes.h"
+    };
+    #undef INSTR_CASE
+
+    if (_jit_disabled) {
+        return NULL;
+    }
+    if (!_jit_init()) {
+        // No executable memory on this host, stay in the block cache
+        _jit_disabled = true;
+        return NULL;
+    }
+    if (_jit_used + JIT_MAX_BLOCK_SIZE > CPU_RECOMPILER_ARENA) {
+        _jit_flush();
+    }
+    u8* entry = _jit_pos = _jit_arena + _jit_used;
+    if (!_jit_protect(entry, JIT_MAX_BLOCK_SIZE, PROT_READ | PROT_WRITE)) {
+        _jit_disabled = true;
+        return NULL;
+    }
+    _jit_fix_count = 0;
+
+    _jit_u8(0x53);                                                  // push rbx
+    _jit_u8(0x41); _jit_u8(0x54);                                   // push r12
+    _jit_u8(0x41); _jit_u8(0x55);                                   // push r13
+    _jit_reg(0x89, 1, JIT_RDI, JIT_RBX);                            // mov rbx, rdi
+    _jit_mov64(JIT_R12, (u64)&_cpu_code_writes);
+    _jit_mem(0x8B, 0, JIT_R13, JIT_R12, 0);                        // mov r13d, [r12]
+
+    u16 pcs[CPU_BLOCK_MAX + 1];
+    u8* resume[CPU_BLOCK_MAX];
+    bool native[CPU_BLOCK_MAX] = { false };
+    bool flow = false;
+    u8 last = block.Count - 1;
+    pcs[0] = block.Start;
+    for (u8 i = 0; i < block.Count; ++i) {
+        const stDecoded& instr = block.Instr[i];
+        pcs[i + 1] = (u16)(pcs[i] + instr.Size);
+
+        u8* start = _jit_pos;
+        u32 fixes = _jit_fix_count;
+        native[i] = _jit_native(instr, _jit_info[instr.OpCode], pcs[i], i, flow);
+        if (!native[i]) {
+            _jit_pos = start;
+            _jit_fix_count = fixes;
+            _jit_call(instr, pcs[i]);
+            if (i != last) {
+                _jit_writes(i);
+            }
+        }
+        resume[i] = _jit_pos;
+        if (i != last) {
+            _jit_mem(0x8B, 1, JIT_RAX, JIT_RBX, JIT_CPU_CYCLES);   // mov rax, [rbx + Cycles]
+            _jit_mem(0x3B, 1, JIT_RAX, JIT_R12, _jit_global(&_cpu_scheduler.End));  // cmp rax, [End]
+            _jit_stub(JIT_CC_AE, JIT_STUB_EXIT, i);
+        }
+    }
+
+    // Handlers move PC themselves, so does a generated jump
+    if (native[last] && !flow) {
+        _jit_pc(pcs[block.Count]);
+    }
+    _jit_lastOpCode(block.Instr[last].OpCode);
+    _jit_mov32(JIT_RAX, block.Count);
+    u8* epilogue = _jit_pos;
+    _jit_u8(0x41); _jit_u8(0x5D);                                   // pop r13
+    _jit_u8(0x41); _jit_u8(0x5C);                                   // pop r12
+    _jit_u8(0x5B);                                                  // pop rbx
+    _jit_u8(0xC3);                                                  // ret
+
+    u8* stubs[2][CPU_BLOCK_MAX];
+    for (u8 i = 0; i < block.Count; ++i) {
+        const stDecoded& instr = block.Instr[i];
+        if (native[i]) {
+            stubs[JIT_STUB_FALLBACK][i] = _jit_pos;
+            _jit_call(instr, pcs[i]);
+            if (i != last) {
+                _jit_writes(i);
+            }
+            _jit_jmp(resume[i]);
+        }
+        if (i != last) {
+            stubs[JIT_STUB_EXIT][i] = _jit_pos;
+            _jit_pc(pcs[i + 1]);
+            _jit_lastOpCode(instr.OpCode);
+            _jit_mov32(JIT_RAX, i + 1);
+            _jit_jmp(epilogue);
+        }
+    }
+    for (u32 i = 0; i < _jit_fix_count; ++i) {
+        _jit_patch(_jit_fixes[i].At, stubs[_jit_fixes[i].Stub][_jit_fixes[i].Instr]);
+    }
+
+    u32 size = (u32)(_jit_pos - entry);
+    _jit_used += size;
+    if (!_jit_protect(entry, size, PROT_READ | PROT_EXEC)) {
+        _jit_disabled = true;
+        _jit_flush();
+        return NULL;
+    }
+    return (fpNative)entry;
+}
+
+#endif
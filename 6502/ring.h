@@ -0,0 +1,76 @@
+#ifndef __RING_H__
+#define __RING_H__
+
+#include <atomic>
+#include <string.h>
+
+#include "defines.h"
+
+/*************************************************************/
+/*************************************************************/
+/*************************** RING ****************************/
+/*************************************************************/
+/*************************************************************/
+// Lock-free queue of bytes between one producer and one consumer, on two threads or the same one. Head
+// is only written by the producer and Tail only by the consumer, each on its own cache line, the bytes
+// are published by the release store of Head (and freed by the one of Tail). Both count up without
+// wrapping at the size, Head - Tail is what the ring holds
+//    RING_SIZE - bytes, a power of 2
+#ifndef RING_SIZE
+#define RING_SIZE               4096
+#endif
+
+typedef struct {
+    alignas(64) std::atomic<u32> Head;     // Next byte written
+    alignas(64) std::atomic<u32> Tail;     // Next byte read
+    alignas(64) u8 Data[RING_SIZE];
+} stRing;
+
+static inline void _ring_init(stRing* ring) {
+    ring->Head.store(0, std::memory_order_relaxed);
+    ring->Tail.store(0, std::memory_order_relaxed);
+}
+
+// Producer, false when the ring is full (nothing is written)
+static inline bool _ring_push(stRing* ring, u8 data) {
+    u32 head = ring->Head.load(std::memory_order_relaxed);
+    if (head - ring->Tail.load(std::memory_order_acquire) == RING_SIZE) {
+        return false;
+    }
+    ring->Data[head & (RING_SIZE - 1)] = data;
+    ring->Head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+// Consumer, false when the ring is empty
+static inline bool _ring_pop(stRing* ring, u8* data) {
+    u32 tail = ring->Tail.load(std::memory_order_relaxed);
+    if (ring->Head.load(std::memory_order_acquire) == tail) {
+        return false;
+    }
+    *data = ring->Data[tail & (RING_SIZE - 1)];
+    ring->Tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+// Consumer, up to size bytes in one go, returns how many were read
+static inline u32 _ring_read(stRing* ring, u8* data, u32 size) {
+    u32 tail = ring->Tail.load(std::memory_order_relaxed);
+    u32 count = ring->Head.load(std::memory_order_acquire) - tail;
+    if (count > size) {
+        count = size;
+    }
+    u32 start = tail & (RING_SIZE - 1);
+    u32 first = count < RING_SIZE - start ? count : RING_SIZE - start;
+    memcpy(data, ring->Data + start, first);
+    memcpy(data + first, ring->Data, count - first);
+    ring->Tail.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+// Either side, only a snapshot when the other one is running
+static inline u32 _ring_count(stRing* ring) {
+    return ring->Head.load(std::memory_order_acquire) - ring->Tail.load(std::memory_order_acquire);
+}
+
+#endif
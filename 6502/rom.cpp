@@ -0,0 +1,76 @@
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <stddef.h>
+
+#include "rom.h"
+
+/*************************************************************/
+/*************************************************************/
+/**************************** ROM ****************************/
+/*************************************************************/
+/*************************************************************/
+#ifdef _WIN32
+
+const u8* _rom_open(const char* path, u32* size) {
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+    LARGE_INTEGER length;
+    const u8* rom = NULL;
+    if (GetFileSizeEx(file, &length) && length.QuadPart > 0 && length.QuadPart <= 0x10000) {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            // The view keeps the mapping alive, neither handle is needed anymore
+            rom = (const u8*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+        if (rom) {
+            *size = (u32)length.QuadPart;
+        }
+    }
+    CloseHandle(file);
+    return rom;
+}
+
+void _rom_close(const u8* rom, u32 size) {
+    (void)size;
+    if (rom) {
+        UnmapViewOfFile(rom);
+    }
+}
+
+#else
+
+const u8* _rom_open(const char* path, u32* size) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat info;
+    const u8* rom = NULL;
+    if (fstat(fd, &info) == 0 && info.st_size > 0 && info.st_size <= 0x10000) {
+        // Shared, the pages are the ones of the file cache whoever maps the image
+        void* mem = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mem != MAP_FAILED) {
+            rom = (const u8*)mem;
+            *size = (u32)info.st_size;
+        }
+    }
+    close(fd);
+    return rom;
+}
+
+void _rom_close(const u8* rom, u32 size) {
+    if (rom) {
+        munmap((void*)rom, size);
+    }
+}
+
+#endif
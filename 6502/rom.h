@@ -0,0 +1,23 @@
+#ifndef __ROM_H__
+#define __ROM_H__
+
+#include "defines.h"
+
+/*************************************************************/
+/*************************************************************/
+/**************************** ROM ****************************/
+/*************************************************************/
+/*************************************************************/
+// ROM images are mapped read-only from their file instead of being compiled in or copied, every
+// machine and every process using the same image shares the pages of the host file cache. The
+// pointer goes straight to _cpu_mapROM (a last partial page reads as 0 past the end of the file)
+//
+//    u32 size;
+//    const u8* rom = _rom_open("ehbasic.rom", &size);
+//    _cpu_mapROM(0xC000, size, rom);
+//    ...
+//    _rom_close(rom, size);
+const u8*   _rom_open(const char* path, u32* size);     // NULL when the file cannot be mapped (or is empty)
+void        _rom_close(const u8* rom, u32 size);
+
+#endif
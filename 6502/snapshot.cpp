@@ -0,0 +1,172 @@
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#define open                        _open
+#define close                       _close
+#define read                        _read
+#define write                       _write
+#else
+#include <unistd.h>
+#define O_BINARY                    0
+#endif
+
+#include "snapshot.h"
+
+/*************************************************************/
+/*************************************************************/
+/************************* SNAPSHOT **************************/
+/*************************************************************/
+/*************************************************************/
+// Why the last save / load failed, NULL for a load that found no file
+static const char* _snapshot_reason;
+static char _snapshot_text[128];
+
+static bool _snapshot_fail(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(_snapshot_text, sizeof(_snapshot_text), format, args);
+    va_end(args);
+    _snapshot_reason = _snapshot_text;
+    return false;
+}
+
+const char* _snapshot_error() {
+    return _snapshot_reason;
+}
+
+static bool _snapshot_write(int fd, const void* data, u32 size) {
+    const u8* bytes = (const u8*)data;
+    while (size) {
+        int written = (int)write(fd, bytes, size);
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        size -= written;
+    }
+    return true;
+}
+
+// Bytes read, less than size at the end of the file or on an error
+static u32 _snapshot_read(int fd, u8* data, u32 size) {
+    u32 total = 0;
+    while (total < size) {
+        int got = (int)read(fd, data + total, size - total);
+        if (got <= 0) {
+            break;
+        }
+        total += got;
+    }
+    return total;
+}
+
+u32 _snapshot_rom(const u8* image, u32 size) {
+    u32 hash = 2166136261u;
+    for (u32 i = 0; i < size; ++i) {
+        hash = (hash ^ image[i]) * 16777619u;
+    }
+    return (hash ^ size) * 16777619u;
+}
+
+bool _snapshot_save(const char* path, const stCPU* cpu, const u8* memory, u32 rom) {
+    stSnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Magic, SNAPSHOT_MAGIC, sizeof(header.Magic));
+    header.Version = SNAPSHOT_VERSION;
+    header.Size = sizeof(header);
+    header.Cycles = cpu->Cycles;
+    header.ProgramCounter = cpu->PC;
+    header.Accumulator = cpu->A;
+    header.IndexX = cpu->X;
+    header.IndexY = cpu->Y;
+    header.StackPointer = cpu->SP;
+    header.Status = cpu->P.flags;
+    header.Halted = cpu->Halted;
+    header.Rom = rom;
+
+    char temp[1024];
+    if (snprintf(temp, sizeof(temp), "%s.tmp", path) >= (int)sizeof(temp)) {
+        return _snapshot_fail("path too long");
+    }
+    int fd = open(temp, O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0644);
+    if (fd < 0) {
+        return _snapshot_fail("cannot create %s: %s", temp, strerror(errno));
+    }
+    bool done = _snapshot_write(fd, &header, sizeof(header)) && _snapshot_write(fd, memory, SNAPSHOT_MEMORY);
+    done = close(fd) == 0 && done;
+    if (!done) {
+        int error = errno;
+        remove(temp);
+        return _snapshot_fail("cannot write %s: %s", temp, strerror(error));
+    }
+#ifdef _WIN32
+    // rename does not replace an existing file there
+    remove(path);
+#endif
+    if (rename(temp, path) != 0) {
+        int error = errno;
+        remove(temp);
+        return _snapshot_fail("cannot rename %s: %s", temp, strerror(error));
+    }
+    return true;
+}
+
+bool _snapshot_load(const char* path, stCPU* cpu, u8* memory, u32 rom) {
+    int fd = open(path, O_RDONLY | O_BINARY);
+    if (fd < 0) {
+        if (errno == ENOENT) {
+            _snapshot_reason = NULL;
+            return false;
+        }
+        return _snapshot_fail("cannot open it: %s", strerror(errno));
+    }
+    // The whole file in one read (one byte more to see a longer file), nothing is touched before it
+    // is checked
+    u8* file = (u8*)malloc(sizeof(stSnapshotHeader) + SNAPSHOT_MEMORY + 1);
+    if (!file) {
+        close(fd);
+        return _snapshot_fail("out of memory");
+    }
+    u32 size = _snapshot_read(fd, file, sizeof(stSnapshotHeader) + SNAPSHOT_MEMORY + 1);
+    close(fd);
+    stSnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(&header, file, size < sizeof(header) ? size : sizeof(header));
+    bool valid = false;
+    if (size < sizeof(header) || memcmp(header.Magic, SNAPSHOT_MAGIC, sizeof(header.Magic))) {
+        _snapshot_fail("not a snapshot");
+    }
+    else if (header.Version != SNAPSHOT_VERSION || header.Size != sizeof(header)) {
+        _snapshot_fail("version %u, this build reads version %u", header.Version, SNAPSHOT_VERSION);
+    }
+    else if (size != sizeof(header) + SNAPSHOT_MEMORY) {
+        _snapshot_fail("%u bytes instead of %u", size, (u32)(sizeof(header) + SNAPSHOT_MEMORY));
+    }
+    else if (header.Rom != rom) {
+        _snapshot_fail("taken on another ROM (%08x, this one is %08x)", header.Rom, rom);
+    }
+    else {
+        memcpy(memory, file + sizeof(header), SNAPSHOT_MEMORY);
+        valid = true;
+    }
+    free(file);
+    if (!valid) {
+        return false;
+    }
+    cpu->Cycles = header.Cycles;
+    cpu->PC = header.ProgramCounter;
+    cpu->A = header.Accumulator;
+    cpu->X = header.IndexX;
+    cpu->Y = header.IndexY;
+    cpu->SP = header.StackPointer;
+    cpu->P.flags = header.Status;
+    cpu->Halted = header.Halted;
+    cpu->LastOpCode = 0;
+    cpu->Idle = 0;
+    return true;
+}
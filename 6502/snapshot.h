@@ -0,0 +1,55 @@
+#ifndef __SNAPSHOT_H__
+#define __SNAPSHOT_H__
+
+#include "defines.h"
+#include "cpu.h"
+
+/*************************************************************/
+/*************************************************************/
+/************************* SNAPSHOT **************************/
+/*************************************************************/
+/*************************************************************/
+// The registers and the 64KB of memory of a machine, taken between two bursts (any instruction boundary)
+// and restored with a single read of the file. The file is the header below followed by the memory,
+// the header has its own fixed layout (not stCPU) so a snapshot stays valid across builds and core
+// options, Version changes whenever the format does. It also holds the identity of the ROM the machine
+// ran (_snapshot_rom of the image), a snapshot only loads on the same ROM. Devices, events and IRQ
+// lines are not saved, the host sets them up again
+//
+//    u32 rom = _snapshot_rom(image, size);
+//    _snapshot_save("ready.snap", &CPU, _ram_, rom);
+//    ...
+//    if (_snapshot_load("ready.snap", &CPU, _ram_, rom)) {
+//        _cpu_flushCache();                   // memory changed behind the CPU
+//    }
+#define SNAPSHOT_MAGIC              "6502"
+#define SNAPSHOT_VERSION            2
+#define SNAPSHOT_MEMORY             0x10000
+
+typedef struct {
+    char Magic[4];                     // SNAPSHOT_MAGIC
+    u16 Version;                       // SNAPSHOT_VERSION
+    u16 Size;                          // Of the header, the memory follows it
+    u64 Cycles;
+    u16 ProgramCounter;                // Names of their own, "globals.h" turns PC, A... into macros
+    u8 Accumulator;
+    u8 IndexX;
+    u8 IndexY;
+    u8 StackPointer;
+    u8 Status;
+    u8 Halted;                         // 1 when saved jammed on a KIL
+    u32 Rom;                           // _snapshot_rom of the ROM image
+    u8 Reserved[4];
+} stSnapshotHeader;
+
+// The file is written next to path and renamed over it, a session loading it never sees half a snapshot
+bool    _snapshot_save(const char* path, const stCPU* cpu, const u8* memory, u32 rom);
+// false when the file is missing, of another version or size, or taken on another ROM. The whole file is
+// read and checked first, cpu and memory are left as they were when it is refused
+bool    _snapshot_load(const char* path, stCPU* cpu, u8* memory, u32 rom);
+// Why the last _snapshot_save / _snapshot_load returned false, NULL when the file to load did not exist
+const char* _snapshot_error();
+// Identity of a ROM image (FNV-1a of its bytes and its size)
+u32     _snapshot_rom(const u8* image, u32 size);
+
+#endif
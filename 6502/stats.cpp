@@ -0,0 +1,109 @@
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "stats.h"
+
+/*************************************************************/
+/*************************************************************/
+/*************************** STATS ***************************/
+/*************************************************************/
+/*************************************************************/
+#define STATS_BAR               40      // Characters of the longest bar
+
+typedef struct {
+    const char* Mnemonic;
+    const char* Mode;                  // ADDR_* of the table
+} stStatsOp;
+
+#define INSTR_CASE(id, mnemonic, addr_handler, size, cycles, page_cycles, handler) { mnemonic, #addr_handler },
+static const stStatsOp _stats_ops[256] = {
+    #include "opcodes.h"
+};
+#undef INSTR_CASE
+
+static const stStats* _stats_sorted;
+
+// "absolute_x" for ADDR_ABSOLUTE_X
+static const char* _stats_mode(u8 opcode) {
+    static char mode[32];
+    const char* name = _stats_ops[opcode].Mode + 5;
+    size_t i = 0;
+    for (; name[i] && i + 1 < sizeof(mode); ++i) {
+        mode[i] = (char)tolower((unsigned char)name[i]);
+    }
+    mode[i] = 0;
+    return mode;
+}
+
+static bool _stats_branch(u8 opcode) {
+    return !strcmp(_stats_ops[opcode].Mode, "ADDR_RELATIVE");
+}
+
+// Most cycles first, then the opcode
+static int _stats_compare(const void* a, const void* b) {
+    u8 left = *(const u8*)a;
+    u8 right = *(const u8*)b;
+    if (_stats_sorted->Cycles[left] != _stats_sorted->Cycles[right]) {
+        return _stats_sorted->Cycles[left] > _stats_sorted->Cycles[right] ? -1 : 1;
+    }
+    return left - right;
+}
+
+void _stats_histogram(FILE* file, const stStats* stats) {
+    u8 order[256];
+    u32 used = 0;
+    u64 count = 0;
+    u64 cycles = 0;
+    for (u32 i = 0; i < 256; ++i) {
+        if (stats->Count[i]) {
+            order[used++] = (u8)i;
+            count += stats->Count[i];
+            cycles += stats->Cycles[i];
+        }
+    }
+    fprintf(file, "%llu instructions, %llu cycles, %u opcodes\n", (unsigned long long)count, (unsigned long long)cycles, used);
+    if (!used) {
+        return;
+    }
+    _stats_sorted = stats;
+    qsort(order, used, sizeof(order[0]), _stats_compare);
+
+    u64 top = stats->Cycles[order[0]];
+    for (u32 i = 0; i < used; ++i) {
+        u8 op = order[i];
+        char bar[STATS_BAR + 1];
+        u32 length = top ? (u32)((stats->Cycles[op] * STATS_BAR + top - 1) / top) : 0;
+        memset(bar, '#', length);
+        bar[length] = 0;
+        bool more = stats->PageCross[op] || _stats_branch(op);
+        fprintf(file, "%02x %s %-12s %12llu %6.2f%% %12llu %6.2f%% %-*s", op, _stats_ops[op].Mnemonic, _stats_mode(op),
+                (unsigned long long)stats->Count[op], stats->Count[op] * 100.0 / count,
+                (unsigned long long)stats->Cycles[op], cycles ? stats->Cycles[op] * 100.0 / cycles : 0.0, more ? STATS_BAR : 0, bar);
+        if (stats->PageCross[op]) {
+            fprintf(file, " page %llu", (unsigned long long)stats->PageCross[op]);
+        }
+        if (_stats_branch(op)) {
+            fprintf(file, " taken %llu / %llu", (unsigned long long)stats->Taken[op], (unsigned long long)stats->Count[op]);
+        }
+        fprintf(file, "\n");
+    }
+}
+
+void _stats_csv(FILE* file, const stStats* stats) {
+    fprintf(file, "opcode,mnemonic,mode,count,cycles,page_crossings,taken,not_taken\n");
+    for (u32 i = 0; i < 256; ++i) {
+        if (!stats->Count[i]) {
+            continue;
+        }
+        u8 op = (u8)i;
+        fprintf(file, "0x%02x,%s,%s,%llu,%llu,%llu,", op, _stats_ops[op].Mnemonic, _stats_mode(op),
+                (unsigned long long)stats->Count[op], (unsigned long long)stats->Cycles[op], (unsigned long long)stats->PageCross[op]);
+        if (_stats_branch(op)) {
+            fprintf(file, "%llu,%llu\n", (unsigned long long)stats->Taken[op], (unsigned long long)(stats->Count[op] - stats->Taken[op]));
+        }
+        else {
+            fprintf(file, ",\n");
+        }
+    }
+}
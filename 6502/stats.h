@@ -0,0 +1,24 @@
+#ifndef __STATS_H__
+#define __STATS_H__
+
+#include <stdio.h>
+
+#include "defines.h"
+#include "cpu.h"
+
+/*************************************************************/
+/*************************************************************/
+/*************************** STATS ***************************/
+/*************************************************************/
+/*************************************************************/
+// Prints the counters of a CPU_STATS build (_cpu_getStats), opcodes that never ran are left out
+//
+//    _stats_histogram(stderr, _cpu_getStats());
+//
+// The histogram is sorted on cycles, the share of the total is shown as a bar. The CSV has one line
+// per opcode: opcode,mnemonic,mode,count,cycles,page_crossings,taken,not_taken (the last two only
+// for branches)
+void    _stats_histogram(FILE* file, const stStats* stats);
+void    _stats_csv(FILE* file, const stStats* stats);
+
+#endif
@@ -0,0 +1,100 @@
+#include <chrono>
+#include <thread>
+#ifdef _WIN32
+#include <windows.h>
+#include <mmsystem.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "winmm.lib")
+#endif
+#endif
+
+#include "throttle.h"
+
+/*************************************************************/
+/*************************************************************/
+/************************ HOST CLOCK *************************/
+/*************************************************************/
+/*************************************************************/
+static u64 _throttle_now() {
+    return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// What is left of a wait after the sleep is spun
+#define THROTTLE_SPIN_NS            50000
+
+// Host time to cycles and back, whole seconds apart so that long sessions do not overflow
+static u64 _throttle_cycles(u64 ns, u32 frequency) {
+    return (ns / 1000000000) * frequency + (ns % 1000000000) * frequency / 1000000000;
+}
+
+static u64 _throttle_ns(u64 cycles, u32 frequency) {
+    return (cycles / frequency) * 1000000000 + (cycles % frequency) * 1000000000 / frequency;
+}
+
+/*************************************************************/
+/*************************************************************/
+/************************* THROTTLE **************************/
+/*************************************************************/
+/*************************************************************/
+// Also used to change the clock, cycles is the current cycle count of the CPU
+void _throttle_init(stThrottle* throttle, u32 frequency, u64 cycles) {
+#ifdef _WIN32
+    // The default timer granularity (15.6ms) would leave every wait to the spin loop
+    static bool period = timeBeginPeriod(1) == TIMERR_NOERROR;
+    (void)period;
+#endif
+    throttle->Frequency = frequency;
+    throttle->Origin = _throttle_now();
+    throttle->OriginCycles = cycles;
+    throttle->Oversleep = 200000;      // Not measured yet, 200us
+}
+
+// Cycles the CPU can run now, what it is behind the host clock plus one slice
+u32 _throttle_budget(stThrottle* throttle, u64 cycles) {
+    if (!throttle->Frequency) {
+        return CPU_THROTTLE_UNLIMITED;
+    }
+    u64 now = _throttle_now();
+    u64 due = throttle->OriginCycles + _throttle_cycles(now - throttle->Origin, throttle->Frequency);
+    if (due > cycles + (u64)throttle->Frequency * CPU_THROTTLE_MAX_LAG_US / 1000000) {
+        // Too far behind to catch up, the clock starts again from here
+        throttle->Origin = now;
+        throttle->OriginCycles = due = cycles;
+    }
+    u64 slice = (u64)throttle->Frequency * CPU_THROTTLE_SLICE_US / 1000000 + 1;
+    return cycles < due + slice ? (u32)(due + slice - cycles) : 0;
+}
+
+// Returns once the host clock reached cycles. Host sleeps wake up late (timer granularity, scheduling),
+// the sleep asked for is what is left minus the average overshoot so it ends close to the target,
+// only the last few microseconds are spun (yielding the CPU)
+void _throttle_wait(stThrottle* throttle, u64 cycles) {
+    if (!throttle->Frequency || cycles <= throttle->OriginCycles) {
+        return;
+    }
+    u64 target = throttle->Origin + _throttle_ns(cycles - throttle->OriginCycles, throttle->Frequency);
+    bool slept = false;
+    for (;;) {
+        u64 now = _throttle_now();
+        if (now >= target) {
+            break;
+        }
+        u64 left = target - now;
+        if (left > throttle->Oversleep + THROTTLE_SPIN_NS) {
+            u64 request = left - throttle->Oversleep;
+            std::this_thread::sleep_for(std::chrono::nanoseconds(request));
+            u64 slept_ns = _throttle_now() - now;
+            i64 over = slept_ns > request ? (i64)(slept_ns - request) : 0;
+            // Moving average, a single late wake up only moves it by an eighth
+            throttle->Oversleep = (u64)((i64)throttle->Oversleep + (over - (i64)throttle->Oversleep) / 8);
+            slept = true;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    if (!slept) {
+        // Spun all the way, the estimate may be too high to ever sleep again, let it come down
+        throttle->Oversleep -= throttle->Oversleep / 8;
+    }
+}
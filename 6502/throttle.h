@@ -0,0 +1,47 @@
+#ifndef __THROTTLE_H__
+#define __THROTTLE_H__
+
+#include "defines.h"
+
+/*************************************************************/
+/*************************************************************/
+/************************* THROTTLE **************************/
+/*************************************************************/
+/*************************************************************/
+// Keeps the CPU at a given clock in real time. The guest runs ahead of the host clock by at most one
+// slice (0.5ms of guest time by default) and the host waits for it, so the emulated time never drifts
+// and never jumps by more than a slice. Only works with cycle counts, it does not know about the CPU
+//
+//    stThrottle throttle;
+//    _throttle_init(&throttle, 1000000, CPU.Cycles);
+//    while (running) {
+//        _cpu_run(_throttle_budget(&throttle, CPU.Cycles));
+//        _throttle_wait(&throttle, CPU.Cycles);
+//    }
+//
+//    CPU_THROTTLE_SLICE_US   - guest time run in one go, also the worst jitter
+//    CPU_THROTTLE_MAX_LAG_US - when the host falls further behind (suspended, debugger) the lost time is
+//                              dropped instead of being caught up at full speed
+#ifndef CPU_THROTTLE_SLICE_US
+#define CPU_THROTTLE_SLICE_US       500
+#endif
+
+#ifndef CPU_THROTTLE_MAX_LAG_US
+#define CPU_THROTTLE_MAX_LAG_US     100000
+#endif
+
+// Budget of a slice when the clock is unlimited
+#define CPU_THROTTLE_UNLIMITED      100000
+
+typedef struct {
+    u32 Frequency;                     // Hz, 0 for unlimited
+    u64 Origin;                        // Host time (ns) of OriginCycles
+    u64 OriginCycles;
+    u64 Oversleep;                     // Average overshoot of the host sleep (ns)
+} stThrottle;
+
+void    _throttle_init(stThrottle* throttle, u32 frequency, u64 cycles);
+u32     _throttle_budget(stThrottle* throttle, u64 cycles);
+void    _throttle_wait(stThrottle* throttle, u64 cycles);
+
+#endif
@@ -0,0 +1,316 @@
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../bench.h"
+#include "cpu.h"
+
+/*************************************************************/
+/*************************************************************/
+/************************ BASIC BENCH ************************/
+/*************************************************************/
+/*************************************************************/
+// EhBASIC (the ROM compiled in) running a fixed corpus of programs, built on the files of
+// example/simple_calc in batch mode:
+//    basic [-dir path] [-reps n] [-cpu n] [-json file] [-baseline file] [-threshold percent] [-update]
+//    -dir        where the .bas and .golden files are (default bench/basic)
+//    -reps       runs of every workload, the fastest one is reported (default 5)
+//    -cpu        pins the process to that host CPU (Linux / Windows)
+//    -json       writes the results to the file ("-" for stdout, the table then goes to stderr)
+//    -baseline   results of an earlier -json, a workload slower than it by more than -threshold percent
+//                (default 10) is a regression
+//    -update     writes the golden files from this run instead of checking them
+// A workload is typed in at the Ready prompt (not timed), then its command is typed and the guest runs
+// in bursts of _cpu_exec until it prints Ready again. _cpu_exec runs an exact count of instructions,
+// so instructions and cycles are the same from run to run and build to build as long as the guest does
+// the same work (they include the input loop from Ready to the end of the last burst). Exits with 1
+// when an output differs from its golden file, 2 on a regression
+#define BASIC_BURST             10000
+#define BASIC_CYCLES            2000000000ull   // A workload that takes longer is broken
+#define BASIC_READY             "Ready\r\n"
+
+typedef struct {
+    const char* Name;
+    const char* Command;
+} stWorkload;
+
+static const stWorkload _basic_workloads[] = {
+    { "sieve",      "RUN" },        // Integer loops and array stores
+    { "trig",       "RUN" },        // Floating point functions
+    { "strings",    "RUN" },        // Concatenation, slicing, garbage collection
+    { "sort",       "RUN" },        // Array reads / writes and branches
+    { "list",       "LIST" },       // Detokenizing a 1000 line program
+};
+
+typedef struct {
+    std::string Name;
+    double Ms;
+    u64 Cycles;
+    u64 Instructions;
+} stBasicResult;
+
+// Machine at the Ready prompt, every run starts from it
+static stCPU _basic_cpu;
+static u8 _basic_ram[RAM_SIZE];
+
+// What the guest printed since the command was typed, up to the Ready that follows it
+static std::string _basic_output;
+static bool _basic_ready;
+
+static void _basic_capture(const u8* data, u32 size) {
+    if (_basic_ready) {
+        return;
+    }
+    size_t from = _basic_output.size() > sizeof(BASIC_READY) ? _basic_output.size() - sizeof(BASIC_READY) : 0;
+    _basic_output.append((const char*)data, size);
+    size_t at = _basic_output.find(BASIC_READY, from);
+    if (at != std::string::npos) {
+        _basic_output.resize(at + strlen(BASIC_READY));
+        _basic_ready = true;
+    }
+}
+
+static bool _basic_read(const std::string& path, std::string* text) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    *text = content.str();
+    return true;
+}
+
+// Golden files have LF line ends whatever git did to them, the guest prints CR LF
+static std::string _basic_lines(const std::string& text) {
+    std::string lines;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] != '\r') {
+            lines += text[i];
+        }
+    }
+    return lines;
+}
+
+// Types text at the Ready prompt and runs until BASIC waits for the next line
+static void _basic_type(const std::string& text) {
+    size_t typed = 0;
+    for (;;) {
+        while (typed < text.size() && _input_push((u8)(text[typed] == '\n' ? '\r' : text[typed]))) {
+            typed++;
+        }
+        _cpu_run(BASIC_BURST * 10);
+        _output_flush();
+        if (typed == text.size() && _input_waiting()) {
+            break;
+        }
+    }
+}
+
+static bool _basic_run(const stWorkload& workload, const std::string& program, stBasicResult* result) {
+    CPU = _basic_cpu;
+    memcpy(_ram_, _basic_ram, RAM_SIZE);
+    _cpu_flushCache();
+    _input_clear();
+    _basic_type(_basic_lines(program));
+
+    _basic_output.clear();
+    _basic_ready = false;
+    std::string command = std::string(workload.Command) + "\r";
+    for (size_t i = 0; i < command.size(); ++i) {
+        _input_push((u8)command[i]);
+    }
+    u64 start = CPU.Cycles;
+    u64 instructions = 0;
+    double begin = _bench_now();
+    while (!_basic_ready && !CPU.Halted && CPU.Cycles - start < BASIC_CYCLES) {
+        _cpu_exec(BASIC_BURST);
+        _output_flush();
+        instructions += BASIC_BURST;
+    }
+    result->Ms = (_bench_now() - begin) / 1000000.0;
+    result->Cycles = CPU.Cycles - start;
+    result->Instructions = instructions;
+    return _basic_ready;
+}
+
+// Reads back what _basic_json wrote, one workload per line
+static void _basic_baseline(const char* path, std::vector<stBasicResult>* baseline) {
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        char name[64];
+        stBasicResult result;
+        unsigned long long cycles;
+        unsigned long long instructions;
+        if (sscanf(line.c_str(), " { \"name\": \"%63[^\"]\", \"ms\": %lf, \"cycles\": %llu, \"instructions\": %llu",
+                   name, &result.Ms, &cycles, &instructions) == 4) {
+            result.Name = name;
+            result.Cycles = cycles;
+            result.Instructions = instructions;
+            baseline->push_back(result);
+        }
+    }
+}
+
+static void _basic_json(FILE* file, const std::vector<stBasicResult>& results, u32 reps) {
+    fprintf(file, "{\n");
+    fprintf(file, "  \"benchmark\": \"basic\",\n");
+    fprintf(file, "  \"engine\": \"%s\",\n", _bench_engine());
+    fprintf(file, "  \"repetitions\": %u,\n", reps);
+    fprintf(file, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const stBasicResult& result = results[i];
+        fprintf(file, "    { \"name\": \"%s\", \"ms\": %.3f, \"cycles\": %llu, \"instructions\": %llu, \"mhz\": %.2f }%s\n",
+                result.Name.c_str(), result.Ms, (unsigned long long)result.Cycles, (unsigned long long)result.Instructions,
+                (double)result.Cycles / (result.Ms * 1000.0), i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n");
+    fprintf(file, "}\n");
+}
+
+int main(int argc, char** argv) {
+    std::string dir = "bench/basic";
+    u32 reps = 5;
+    int cpu = -1;
+    const char* json = NULL;
+    const char* baselinePath = NULL;
+    double threshold = 10.0;
+    bool update = false;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-update")) {
+            update = true;
+        }
+        else if (i + 1 < argc && !strcmp(argv[i], "-dir")) {
+            dir = argv[++i];
+        }
+        else if (i + 1 < argc && !strcmp(argv[i], "-reps")) {
+            reps = (u32)strtoul(argv[++i], NULL, 0);
+        }
+        else if (i + 1 < argc && !strcmp(argv[i], "-cpu")) {
+            cpu = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && !strcmp(argv[i], "-json")) {
+            json = argv[++i];
+        }
+        else if (i + 1 < argc && !strcmp(argv[i], "-baseline")) {
+            baselinePath = argv[++i];
+        }
+        else if (i + 1 < argc && !strcmp(argv[i], "-threshold")) {
+            threshold = atof(argv[++i]);
+        }
+        else {
+            fprintf(stderr, "usage: %s [-dir path] [-reps n] [-cpu n] [-json file] [-baseline file] [-threshold percent] [-update]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (!reps) {
+        reps = 1;
+    }
+    if (cpu >= 0 && !_bench_pin(cpu)) {
+        fprintf(stderr, "Cannot pin to CPU %d\n", cpu);
+        return 1;
+    }
+    std::vector<stBasicResult> baseline;
+    if (baselinePath) {
+        _basic_baseline(baselinePath, &baseline);
+        if (baseline.empty()) {
+            fprintf(stderr, "No results in %s\n", baselinePath);
+            return 1;
+        }
+    }
+
+    _console_init(NULL);
+    _console_batch(_basic_capture);
+    _cpu_reset();
+    _console_boot();
+    _output_flush();
+    _basic_cpu = CPU;
+    memcpy(_basic_ram, _ram_, RAM_SIZE);
+
+    // Only the JSON on stdout when it goes there
+    FILE* table = json && !strcmp(json, "-") ? stderr : stdout;
+    fprintf(table, "%s engine, best of %u runs\n", _bench_engine(), reps);
+    int status = 0;
+    std::vector<stBasicResult> results;
+    for (size_t w = 0; w < sizeof(_basic_workloads) / sizeof(_basic_workloads[0]); ++w) {
+        const stWorkload& workload = _basic_workloads[w];
+        std::string program;
+        if (!_basic_read(dir + "/" + workload.Name + ".bas", &program)) {
+            fprintf(stderr, "Cannot read %s/%s.bas\n", dir.c_str(), workload.Name);
+            status = 1;
+            continue;
+        }
+
+        stBasicResult best;
+        best.Name = workload.Name;
+        bool done = true;
+        for (u32 r = 0; r < reps && done; ++r) {
+            stBasicResult run;
+            done = _basic_run(workload, program, &run);
+            if (!r || run.Ms < best.Ms) {
+                best.Ms = run.Ms;
+                best.Cycles = run.Cycles;
+                best.Instructions = run.Instructions;
+            }
+        }
+        if (!done) {
+            fprintf(stderr, "%s: no Ready after %llu cycles\n", workload.Name, (unsigned long long)best.Cycles);
+            status = 1;
+            continue;
+        }
+
+        // Output against the golden file
+        std::string output = _basic_lines(_basic_output);
+        std::string goldenPath = dir + "/" + workload.Name + ".golden";
+        const char* check = "ok";
+        if (update) {
+            std::ofstream golden(goldenPath.c_str(), std::ios::binary);
+            golden << output;
+            check = golden ? "updated" : "not written";
+        }
+        else {
+            std::string golden;
+            if (!_basic_read(goldenPath, &golden) || _basic_lines(golden) != output) {
+                check = "OUTPUT DIFFERS";
+                status = 1;
+            }
+        }
+
+        fprintf(table, "%-8s %10.3f ms %12llu cycles %12llu instructions %8.2f MHz  %s", workload.Name, best.Ms,
+                (unsigned long long)best.Cycles, (unsigned long long)best.Instructions,
+                (double)best.Cycles / (best.Ms * 1000.0), check);
+        for (size_t b = 0; b < baseline.size(); ++b) {
+            if (baseline[b].Name == best.Name) {
+                double change = (best.Ms / baseline[b].Ms - 1.0) * 100.0;
+                fprintf(table, "  %+.1f%%", change);
+                if (change > threshold) {
+                    fprintf(table, " REGRESSION");
+                    status = status ? status : 2;
+                }
+                if (baseline[b].Instructions != best.Instructions) {
+                    fprintf(table, " (instructions were %llu)", (unsigned long long)baseline[b].Instructions);
+                }
+            }
+        }
+        fprintf(table, "\n");
+        results.push_back(best);
+    }
+
+    if (json) {
+        FILE* file = strcmp(json, "-") ? fopen(json, "w") : stdout;
+        if (!file) {
+            fprintf(stderr, "Cannot write %s\n", json);
+            return 1;
+        }
+        _basic_json(file, results, reps);
+        if (file != stdout) {
+            fclose(file);
+        }
+    }
+    return status;
+}
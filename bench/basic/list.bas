@@ -0,0 +1,1001 @@
+1000 IF A>B THEN A=B:IF A>B THEN A=B
+1010 POKE 768,N AND 255:X=SIN(Y)*COS(Z)
+1020 GOSUB 20000:A$=LEFT$(B$,3)+"X"
+1030 REM KEEP THIS LINE:PRINT TAB(10);"HELLO";
+1040 READ D:DATA 1,2,3:ON K GOTO 1000,1010,1020
+1050 FOR I=1 TO 10:T=T+I:NEXT I:POKE 768,N AND 255
+1060 X=SIN(Y)*COS(Z):PRINT TAB(10);"HELLO";
+1070 S$=STR$(N)+CHR$(13):REM KEEP THIS LINE
+1080 X=SIN(Y)*COS(Z):GOSUB 20000
+1090 A$=LEFT$(B$,3)+"X":DIM Q(20)
+1100 FOR I=1 TO 10:T=T+I:NEXT I:ON K GOTO 1000,1010,1020
+1110 DIM Q(20):REM KEEP THIS LINE
+1120 POKE 768,N AND 255:DIM Q(20)
+1130 A$=LEFT$(B$,3)+"X":FOR I=1 TO 10:T=T+I:NEXT I
+1140 READ D:DATA 1,2,3:REM KEEP THIS LINE
+1150 DIM Q(20):READ D:DATA 1,2,3
+1160 PRINT "TOTAL";T:S$=STR$(N)+CHR$(13)
+1170 GOSUB 20000:X=SIN(Y)*COS(Z)
+1180 ON K GOTO 1000,1010,1020:PRINT "TOTAL";T
+1190 X=SIN(Y)*COS(Z):ON K GOTO 1000,1010,1020
+1200 ON K GOTO 1000,1010,1020:READ D:DATA 1,2,3
+1210 X=SIN(Y)*COS(Z):REM KEEP THIS LINE
+1220 GOSUB 20000:REM KEEP THIS LINE
+1230 A$=LEFT$(B$,3)+"X":PRINT "TOTAL";T
+1240 DIM Q(20):A$=LEFT$(B$,3)+"X"
+1250 READ D:DATA 1,2,3:READ D:DATA 1,2,3
+1260 Y=INT(RND(1)*100):READ D:DATA 1,2,3
+1270 READ D:DATA 1,2,3:FOR I=1 TO 10:T=T+I:NEXT I
+1280 IF A>B THEN A=B:IF A>B THEN A=B
+1290 GOSUB 20000:FOR I=1 TO 10:T=T+I:NEXT I
+1300 GOSUB 20000:PRINT TAB(10);"HELLO";
+1310 PRINT TAB(10);"HELLO";:DIM Q(20)
+1320 Y=INT(RND(1)*100):READ D:DATA 1,2,3
+1330 ON K GOTO 1000,1010,1020:GOSUB 20000
+1340 X=SIN(Y)*COS(Z):ON K GOTO 1000,1010,1020
+1350 REM KEEP THIS LINE:X=SIN(Y)*COS(Z)
+1360 GOSUB 20000:Y=INT(RND(1)*100)
+1370 REM KEEP THIS LINE:Y=INT(RND(1)*100)
+1380 A$=LEFT$(B$,3)+"X":READ D:DATA 1,2,3
+1390 ON K GOTO 1000,1010,1020:REM KEEP THIS LINE
+1400 GOSUB 20000:Y=INT(RND(1)*100)
+1410 GOSUB 20000:A$=LEFT$(B$,3)+"X"
+1420 PRINT TAB(10);"HELLO";:X=SIN(Y)*COS(Z)
+1430 GOSUB 20000:ON K GOTO 1000,1010,1020
+1440 Y=INT(RND(1)*100):ON K GOTO 1000,1010,1020
+1450 IF A>B THEN A=B:READ D:DATA 1,2,3
+1460 Y=INT(RND(1)*100):REM KEEP THIS LINE
+1470 POKE 768,N AND 255:IF A>B THEN A=B
+1480 S$=STR$(N)+CHR$(13):S$=STR$(N)+CHR$(13)
+1490 PRINT "TOTAL";T:GOSUB 20000
+1500 IF A>B THEN A=B:REM KEEP THIS LINE
+1510 READ D:DATA 1,2,3:IF A>B THEN A=B
+1520 X=SIN(Y)*COS(Z):ON K GOTO 1000,1010,1020
+1530 PRINT "TOTAL";T:READ D:DATA 1,2,3
+1540 X=SIN(Y)*COS(Z):A$=LEFT$(B$,3)+"X"
+1550 POKE 768,N AND 255:PRINT "TOTAL";T
+1560 X=SIN(Y)*COS(Z):IF A>B THEN A=B
+1570 Y=INT(RND(1)*100):POKE 768,N AND 255
+1580 FOR I=1 TO 10:T=T+I:NEXT I:GOSUB 20000
+1590 FOR I=1 TO 10:T=T+I:NEXT I:FOR I=1 TO 10:T=T+I:NEXT I
+1600 PRINT "TOTAL";T:REM KEEP THIS LINE
+1610 Y=INT(RND(1)*100):PRINT "TOTAL";T
+1620 REM KEEP THIS LINE:PRINT TAB(10);"HELLO";
+1630 REM KEEP THIS LINE:IF A>B THEN A=B
+1640 ON K GOTO 1000,1010,1020:Y=INT(RND(1)*100)
+1650 PRINT "TOTAL";T:A$=LEFT$(B$,3)+"X"
+1660 FOR I=1 TO 10:T=T+I:NEXT I:S$=STR$(N)+CHR$(13)
+1670 DIM Q(20):GOSUB 20000
+1680 IF A>B THEN A=B:DIM Q(20)
+1690 PRINT "TOTAL";T:ON K GOTO 1000,1010,1020
+1700 X=SIN(Y)*COS(Z):GOSUB 20000
+1710 FOR I=1 TO 10:T=T+I:NEXT I:S$=STR$(N)+CHR$(13)
+1720 REM KEEP THIS LINE:REM KEEP THIS LINE
+1730 GOSUB 20000:ON K GOTO 1000,1010,1020
+1740 S$=STR$(N)+CHR$(13):A$=LEFT$(B$,3)+"X"
+1750 REM KEEP THIS LINE:PRINT "TOTAL";T
+1760 REM KEEP THIS LINE:DIM Q(20)
+1770 S$=STR$(N)+CHR$(13):POKE 768,N AND 255
+1780 ON K GOTO 1000,1010,1020:S$=STR$(N)+CHR$(13)
+1790 DIM Q(20):ON K GOTO 1000,1010,1020
+1800 ON K GOTO 1000,1010,1020:ON K GOTO 1000,1010,1020
+1810 IF A>B THEN A=B:ON K GOTO 1000,1010,1020
+1820 Y=INT(RND(1)*100):PRINT TAB(10);"HELLO";
+1830 S$=STR$(N)+CHR$(13):IF A>B THEN A=B
+1840 READ D:DATA 1,2,3:GOSUB 20000
+1850 IF A>B THEN A=B:REM KEEP THIS LINE
+1860 S$=STR$(N)+CHR$(13):DIM Q(20)
+1870 ON K GOTO 1000,1010,1020:X=SIN(Y)*COS(Z)
+1880 REM KEEP THIS LINE:A$=LEFT$(B$,3)+"X"
+1890 DIM Q(20):POKE 768,N AND 255
+1900 IF A>B THEN A=B:READ D:DATA 1,2,3
+1910 READ D:DATA 1,2,3:PRINT "TOTAL";T
+1920 DIM Q(20):PRINT "TOTAL";T
+1930 PRINT "TOTAL";T:ON K GOTO 1000,1010,1020
+1940 READ D:DATA 1,2,3:IF A>B THEN A=B
+1950 PRINT TAB(10);"HELLO";:POKE 768,N AND 255
+1960 S$=STR$(N)+CHR$(13):GOSUB 20000
+1970 READ D:DATA 1,2,3:ON K GOTO 1000,1010,1020
+1980 S$=STR$(N)+CHR$(13):PRINT "TOTAL";T
+1990 POKE 768,N AND 255:A$=LEFT$(B$,3)+"X"
+2000 POKE 768,N AND 255:PRINT "TOTAL";T
+2010 PRINT "TOTAL";T:FOR I=1 TO 10:T=T+I:NEXT I
+2020 REM KEEP THIS LINE:A$=LEFT$(B$,3)+"X"
+2030 PRINT "TOTAL";T:S$=STR$(N)+CHR$(13)
+2040 POKE 768,N AND 255:IF A>B THEN A=B
+2050 Y=INT(RND(1)*100):A$=LEFT$(B$,3)+"X"
+2060 GOSUB 20000:IF A>B THEN A=B
+2070 X=SIN(Y)*COS(Z):S$=STR$(N)+CHR$(13)
+2080 PRINT TAB(10);"HELLO";:IF A>B THEN A=B
+2090 PRINT TAB(10);"HELLO";:S$=STR$(N)+CHR$(13)
+2100 GOSUB 20000:A$=LEFT$(B$,3)+"X"
+2110 PRINT "TOTAL";T:PRINT TAB(10);"HELLO";
+2120 READ D:DATA 1,2,3:FOR I=1 TO 10:T=T+I:NEXT I
+2130 READ D:DATA 1,2,3:S$=STR$(N)+CHR$(13)
+2140 X=SIN(Y)*COS(Z):ON K GOTO 1000,1010,1020
+2150 FOR I=1 TO 10:T=T+I:NEXT I:PRINT "TOTAL";T
+2160 POKE 768,N AND 255:PRINT "TOTAL";T
+2170 PRINT "TOTAL";T:A$=LEFT$(B$,3)+"X"
+2180 PRINT TAB(10);"HELLO";:REM KEEP THIS LINE
+2190 FOR I=1 TO 10:T=T+I:NEXT I:A$=LEFT$(B$,3)+"X"
+2200 REM KEEP THIS LINE:X=SIN(Y)*COS(Z)
+2210 IF A>B THEN A=B:DIM Q(20)
+2220 READ D:DATA 1,2,3:S$=STR$(N)+CHR$(13)
+2230 A$=LEFT$(B$,3)+"X":DIM Q(20)
+2240 S$=STR$(N)+CHR$(13):IF A>B THEN A=B
+2250 FOR I=1 TO 10:T=T+I:NEXT I:GOSUB 20000
+2260 S$=STR$(N)+CHR$(13):READ D:DATA 1,2,3
+2270 DIM Q(20):PRINT "TOTAL";T
+2280 FOR I=1 TO 10:T=T+I:NEXT I:Y=INT(RND(1)*100)
+2290 POKE 768,N AND 255:S$=STR$(N)+CHR$(13)
+2300 POKE 768,N AND 255:READ D:DATA 1,2,3
+2310 Y=INT(RND(1)*100):PRINT "TOTAL";T
+2320 GOSUB 20000:A$=LEFT$(B$,3)+"X"
+2330 DIM Q(20):POKE 768,N AND 255
+2340 A$=LEFT$(B$,3)+"X":PRINT TAB(10);"HELLO";
+2350 GOSUB 20000:DIM Q(20)
+2360 PRINT "TOTAL";T:Y=INT(RND(1)*100)
+2370 GOSUB 20000:X=SIN(Y)*COS(Z)
+2380 GOSUB 20000:ON K GOTO 1000,1010,1020
+2390 READ D:DATA 1,2,3:REM KEEP THIS LINE
+2400 POKE 768,N AND 255:PRINT "TOTAL";T
+2410 GOSUB 20000:REM KEEP THIS LINE
+2420 REM KEEP THIS LINE:A$=LEFT$(B$,3)+"X"
+2430 DIM Q(20):IF A>B THEN A=B
+2440 S$=STR$(N)+CHR$(13):REM KEEP THIS LINE
+2450 FOR I=1 TO 10:T=T+I:NEXT I:Y=INT(RND(1)*100)
+2460 FOR I=1 TO 10:T=T+I:NEXT I:PRINT "TOTAL";T
+2470 S$=STR$(N)+CHR$(13):GOSUB 20000
+2480 S$=STR$(N)+CHR$(13):X=SIN(Y)*COS(Z)
+2490 PRINT "TOTAL";T:PRINT "TOTAL";T
+2500 POKE 768,N AND 255:X=SIN(Y)*COS(Z)
+2510 PRINT "TOTAL";T:REM KEEP THIS LINE
+2520 REM KEEP THIS LINE:POKE 768,N AND 255
+2530 PRINT TAB(10);"HELLO";:ON K GOTO 1000,1010,1020
+2540 REM KEEP THIS LINE:X=SIN(Y)*COS(Z)
+2550 X=SIN(Y)*COS(Z):REM KEEP THIS LINE
+2560 REM KEEP THIS LINE:ON K GOTO 1000,1010,1020
+2570 ON K GOTO 1000,1010,1020:ON K GOTO 1000,1010,1020
+2580 IF A>B THEN A=B:X=SIN(Y)*COS(Z)
+2590 S$=STR$(N)+CHR$(13):POKE 768,N AND 255
+2600 Y=INT(RND(1)*100):READ D:DATA 1,2,3
+2610 DIM Q(20):S$=STR$(N)+CHR$(13)
+2620 READ D:DATA 1,2,3:S$=STR$(N)+CHR$(13)
+2630 PRINT TAB(10);"HELLO";:POKE 768,N AND 255
+2640 ON K GOTO 1000,1010,1020:IF A>B THEN A=B
+2650 PRINT "TOTAL";T:GOSUB 20000
+2660 S$=STR$(N)+CHR$(13):IF A>B THEN A=B
+2670 POKE 768,N AND 255:REM KEEP THIS LINE
+2680 FOR I=1 TO 10:T=T+I:NEXT I:Y=INT(RND(1)*100)
+2690 READ D:DATA 1,2,3:S$=STR$(N)+CHR$(13)
+2700 PRINT TAB(10);"HELLO";:REM KEEP THIS LINE
+2710 ON K GOTO 1000,1010,1020:PRINT TAB(10);"HELLO";
+2720 GOSUB 20000:S$=STR$(N)+CHR$(13)
+2730 GOSUB 20000:IF A>B THEN A=B
+2740 POKE 768,N AND 255:IF A>B THEN A=B
+2750 A$=LEFT$(B$,3)+"X":POKE 768,N AND 255
+2760 PRINT "TOTAL";T:Y=INT(RND(1)*100)
+2770 IF A>B THEN A=B:S$=STR$(N)+CHR$(13)
+2780 PRINT TAB(10);"HELLO";:PRINT "TOTAL";T
+2790 GOSUB 20000:X=SIN(Y)*COS(Z)
+2800 PRINT TAB(10);"HELLO";:READ D:DATA 1,2,3
+2810 PRINT TAB(10);"HELLO";:POKE 768,N AND 255
+2820 IF A>B THEN A=B:REM KEEP THIS LINE
+2830 PRINT TAB(10);"HELLO";:Y=INT(RND(1)*100)
+2840 PRINT "TOTAL";T:REM KEEP THIS LINE
+2850 FOR I=1 TO 10:T=T+I:NEXT I:S$=STR$(N)+CHR$(13)
+2860 ON K GOTO 1000,1010,1020:PRINT TAB(10);"HELLO";
+2870 POKE 768,N AND 255:ON K GOTO 1000,1010,1020
+2880 POKE 768,N AND 255:X=SIN(Y)*COS(Z)
+2890 IF A>B THEN A=B:IF A>B THEN A=B
+2900 REM KEEP THIS LINE:PRINT "TOTAL";T
+2910 FOR I=1 TO 10:T=T+I:NEXT I:X=SIN(Y)*COS(Z)
+2920 PRINT TAB(10);"HELLO";:S$=STR$(N)+CHR$(13)
+2930 REM KEEP THIS LINE:READ D:DATA 1,2,3
+2940 S$=STR$(N)+CHR$(13):REM KEEP THIS LINE
+2950 PRINT TAB(10);"HELLO";:DIM Q(20)
+2960 ON K GOTO 1000,1010,1020:POKE 768,N AND 255
+2970 ON K GOTO 1000,1010,1020:S$=STR$(N)+CHR$(13)
+2980 PRINT TAB(10);"HELLO";:Y=INT(RND(1)*100)
+2990 X=SIN(Y)*COS(Z):IF A>B THEN A=B
+3000 FOR I=1 TO 10:T=T+I:NEXT I:POKE 768,N AND 255
+3010 IF A>B THEN A=B:X=SIN(Y)*COS(Z)
+3020 A$=LEFT$(B$,3)+"X":PRINT TAB(10);"HELLO";
+3030 PRINT TAB(10);"HELLO";:POKE 768,N AND 255
+3040 ON K GOTO 1000,1010,1020:REM KEEP THIS LINE
+3050 DIM Q(20):GOSUB 20000
+3060 PRINT TAB(10);"HELLO";:REM KEEP THIS LINE
+3070 X=SIN(Y)*COS(Z):ON K GOTO 1000,1010,1020
+3080 FOR I=1 TO 10:T=T+I:NEXT I:ON K GOTO 1000,1010,1020
+3090 DIM Q(20):S$=STR$(N)+CHR$(13)
+3100 PRINT "TOTAL";T:FOR I=1 TO 10:T=T+I:NEXT I
+3110 S$=STR$(N)+CHR$(13):PRINT "TOTAL";T
+3120 A$=LEFT$(B$,3)+"X":READ D:DATA 1,2,3
+3130 POKE 768,N AND 255:X=SIN(Y)*COS(Z)
+3140 REM KEEP THIS LINE:S$=STR$(N)+CHR$(13)
+3150 POKE 768,N AND 255:POKE 768,N AND 255
+3160 Y=INT(RND(1)*100):Y=INT(RND(1)*100)
+3170 X=SIN(Y)*COS(Z):GOSUB 20000
+3180 X=SIN(Y)*COS(Z):Y=INT(RND(1)*100)
+3190 POKE 768,N AND 255:Y=INT(RND(1)*100)
+3200 FOR I=1 TO 10:T=T+I:NEXT I:S$=STR$(N)+CHR$(13)
+3210 FOR I=1 TO 10:T=T+I:NEXT I:IF A>B THEN A=B
+3220 GOSUB 20000:PRINT "TOTAL";T
+3230 ON K GOTO 1000,1010,1020:A$=LEFT$(B$,3)+"X"
+3240 X=SIN(Y)*COS(Z):GOSUB 20000
+3250 X=SIN(Y)*COS(Z):A$=LEFT$(B$,3)+"X"
+3260 POKE 768,N AND 255:S$=STR$(N)+CHR$(13)
+3270 GOSUB 20000:FOR I=1 TO 10:T=T+I:NEXT I
+3280 X=SIN(Y)*COS(Z):IF A>B THEN A=B
+3290 Y=INT(RND(1)*100):X=SIN(Y)*COS(Z)
+3300 GOSUB 20000:ON K GOTO 1000,1010,1020
+3310 POKE 768,N AND 255:READ D:DATA 1,2,3
+3320 FOR I=1 TO 10:T=T+I:NEXT I:REM KEEP THIS LINE
+3330 READ D:DATA 1,2,3:REM KEEP THIS LINE
+3340 Y=INT(RND(1)*100):POKE 768,N AND 255
+3350 READ D:DATA 1,2,3:FOR I=1 TO 10:T=T+I:NEXT I
+3360 POKE 768,N AND 255:POKE 768,N AND 255
+3370 Y=INT(RND(1)*100):IF A>B THEN A=B
+3380 Y=INT(RND(1)*100):FOR I=1 TO 10:T=T+I:NEXT I
+3390 READ D:DATA 1,2,3:IF A>B THEN A=B
+3400 DIM Q(20):REM KEEP THIS LINE
+3410 REM KEEP THIS LINE:READ D:DATA 1,2,3
+3420 REM KEEP THIS LINE:S$=STR$(N)+CHR$(13)
+3430 POKE 768,N AND 255:ON K GOTO 1000,1010,1020
+3440 S$=STR$(N)+CHR$(13):ON K GOTO 1000,1010,1020
+3450 IF A>B THEN A=B:IF A>B THEN A=B
+3460 Y=INT(RND(1)*100):READ D:DATA 1,2,3
+3470 REM KEEP THIS LINE:DIM Q(20)
+3480 PRINT "TOTAL";T:PRINT TAB(10);"HELLO";
+3490 DIM Q(20):IF A>B THEN A=B
+3500 S$=STR$(N)+CHR$(13):READ D:DATA 1,2,3
+3510 A$=LEFT$(B$,3)+"X":A$=LEFT$(B$,3)+"X"
+3520 PRINT TAB(10);"HELLO";:PRINT TAB(10);"HELLO";
+3530 S$=STR$(N)+CHR$(13):FOR I=1 TO 10:T=T+I:NEXT I
+3540 REM KEEP THIS LINE:POKE 768,N AND 255
+3550 IF A>B THEN A=B:S$=STR$(N)+CHR$(13)
+3560 X=SIN(Y)*COS(Z):S$=STR$(N)+CHR$(13)
+3570 S$=STR$(N)+CHR$(13):ON K GOTO 1000,1010,1020
+3580 X=SIN(Y)*COS(Z):S$=STR$(N)+CHR$(13)
+3590 FOR I=1 TO 10:T=T+I:NEXT I:X=SIN(Y)*COS(Z)
+3600 ON K GOTO 1000,1010,1020:A$=LEFT$(B$,3)+"X"
+3610 PRINT "TOTAL";T:ON K GOTO 1000,1010,1020
+3620 IF A>B THEN A=B:GOSUB 20000
+3630 POKE 768,N AND 255:REM KEEP THIS LINE
+3640 DIM Q(20):GOSUB 20000
+3650 ON K GOTO 1000,1010,1020:X=SIN(Y)*COS(Z)
+3660 Y=INT(RND(1)*100):ON K GOTO 1000,1010,1020
+3670 S$=STR$(N)+CHR$(13):FOR I=1 TO 10:T=T+I:NEXT I
+3680 IF A>B THEN A=B:READ D:DATA 1,2,3
+3690 PRINT TAB(10);"HELLO";:PRINT "TOTAL";T
+3700 A$=LEFT$(B$,3)+"X":READ D:DATA 1,2,3
+3710 DIM Q(20):X=SIN(Y)*COS(Z)
+3720 S$=STR$(N)+CHR$(13):FOR I=1 TO 10:T=T+I:NEXT I
+3730 DIM Q(20):PRINT "TOTAL";T
+3740 DIM Q(20):Y=INT(RND(1)*100)
+3750 PRINT "TOTAL";T:Y=INT(RND(1)*100)
+3760 X=SIN(Y)*COS(Z):PRINT TAB(10);"HELLO";
+3770 IF A>B THEN A=B:X=SIN(Y)*COS(Z)
+3780 IF A>B THEN A=B:S$=STR$(N)+CHR$(13)
+3790 S$=STR$(N)+CHR$(13):X=SIN(Y)*COS(Z)
+3800 A$=LEFT$(B$,3)+"X":PRINT TAB(10);"HELLO";
+3810 ON K GOTO 1000,1010,1020:ON K GOTO 1000,1010,1020
+3820 POKE 768,N AND 255:Y=INT(RND(1)*100)
+3830 READ D:DATA 1,2,3:READ D:DATA 1,2,3
+3840 GOSUB 20000:S$=STR$(N)+CHR$(13)
+3850 A$=LEFT$(B$,3)+"X":FOR I=1 TO 10:T=T+I:NEXT I
+3860 DIM Q(20):PRINT "TOTAL";T
+3870 X=SIN(Y)*COS(Z):FOR I=1 TO 10:T=T+I:NEXT I
+3880 GOSUB 20000:REM KEEP THIS LINE
+3890 Y=INT(RND(1)*100):GOSUB 20000
+3900 PRINT TAB(10);"HELLO";:ON K GOTO 1000,1010,1020
+3910 GOSUB 20000:POKE 768,N AND 255
+3920 ON K GOTO 1000,1010,1020:GOSUB 20000
+3930 GOSUB 20000:X=SIN(Y)*COS(Z)
+3940 DIM Q(20):FOR I=1 TO 10:T=T+I:NEXT I
+3950 S$=STR$(N)+CHR$(13):IF A>B THEN A=B
+3960 GOSUB 20000:DIM Q(20)
+3970 POKE 768,N AND 255:IF A>B THEN A=B
+3980 POKE 768,N AND 255:PRINT "TOTAL";T
+3990 S$=STR$(N)+CHR$(13):POKE 768,N AND 255
+4000 A$=LEFT$(B$,3)+"X":READ D:DATA 1,2,3
+4010 REM KEEP THIS LINE:X=SIN(Y)*COS(Z)
+4020 IF A>B THEN A=B:IF A>B THEN A=B
+4030 X=SIN(Y)*COS(Z):PRINT "TOTAL";T
+4040 PRINT "TOTAL";T:IF A>B THEN A=B
+4050 Y=INT(RND(1)*100):PRINT TAB(10);"HELLO";
+4060 PRINT TAB(10);"HELLO";:PRINT TAB(10);"HELLO";
+4070 X=SIN(Y)*COS(Z):REM KEEP THIS LINE
+4080 A$=LEFT$(B$,3)+"X":GOSUB 20000
+4090 S$=STR$(N)+CHR$(13):READ D:DATA 1,2,3
+4100 FOR I=1 TO 10:T=T+I:NEXT I:REM KEEP THIS LINE
+4110 PRINT TAB(10);"HELLO";:A$=LEFT$(B$,3)+"X"
+4120 Y=INT(RND(1)*100):FOR I=1 TO 10:T=T+I:NEXT I
+4130 READ D:DATA 1,2,3:FOR I=1 TO 10:T=T+I:NEXT I
+4140 POKE 768,N AND 255:X=SIN(Y)*COS(Z)
+4150 S$=STR$(N)+CHR$(13):FOR I=1 TO 10:T=T+I:NEXT I
+4160 GOSUB 20000:PRINT TAB(10);"HELLO";
+4170 IF A>B THEN A=B:GOSUB 20000
+4180 POKE 768,N AND 255:POKE 768,N AND 255
+4190 POKE 768,N AND 255:S$=STR$(N)+CHR$(13)
+4200 IF A>B THEN A=B:GOSUB 20000
+4210 PRINT TAB(10);"HELLO";:A$=LEFT$(B$,3)+"X"
+4220 FOR I=1 TO 10:T=T+I:NEXT I:DIM Q(20)
+4230 REM KEEP THIS LINE:DIM Q(20)
+4240 A$=LEFT$(B$,3)+"X":PRINT TAB(10);"HELLO";
+4250 PRINT "TOTAL";T:FOR I=1 TO 10:T=T+I:NEXT I
+4260 PRINT TAB(10);"HELLO";:IF A>B THEN A=B
+4270 REM KEEP THIS LINE:REM KEEP THIS LINE
+4280 GOSUB 20000:PRINT TAB(10);"HELLO";
+4290 PRINT TAB(10);"HELLO";:POKE 768,N AND 255
+4300 S$=STR$(N)+CHR$(13):GOSUB 20000
+4310 ON K GOTO 1000,1010,1020:GOSUB 20000
+4320 GOSUB 20000:Y=INT(RND(1)*100)
+4330 A$=LEFT$(B$,3)+"X":READ D:DATA 1,2,3
+4340 ON K GOTO 1000,1010,1020:A$=LEFT$(B$,3)+"X"
+4350 FOR I=1 TO 10:T=T+I:NEXT I:A$=LEFT$(B$,3)+"X"
+4360 PRINT "TOTAL";T:PRINT "TOTAL";T
+4370 ON K GOTO 1000,1010,1020:Y=INT(RND(1)*100)
+4380 S$=STR$(N)+CHR$(13):READ D:DATA 1,2,3
+4390 PRINT "TOTAL";T:S$=STR$(N)+CHR$(13)
+4400 Y=INT(RND(1)*100):ON K GOTO 1000,1010,1020
+4410 PRINT "TOTAL";T:FOR I=1 TO 10:T=T+I:NEXT I
+4420 A$=LEFT$(B$,3)+"X":S$=STR$(N)+CHR$(13)
+4430 A$=LEFT$(B$,3)+"X":X=SIN(Y)*COS(Z)
+4440 READ D:DATA 1,2,3:Y=INT(RND(1)*100)
+4450 PRINT TAB(10);"HELLO";:Y=INT(RND(1)*100)
+4460 POKE 768,N AND 255:READ D:DATA 1,2,3
+4470 Y=INT(RND(1)*100):A$=LEFT$(B$,3)+"X"
+4480 X=SIN(Y)*COS(Z):FOR I=1 TO 10:T=T+I:NEXT I
+4490 Y=INT(RND(1)*100):PRINT "TOTAL";T
+4500 REM KEEP THIS LINE:S$=STR$(N)+CHR$(13)
+4510 POKE 768,N AND 255:FOR I=1 TO 10:T=T+I:NEXT I
+4520 IF A>B THEN A=B:REM KEEP THIS LINE
+4530 X=SIN(Y)*COS(Z):X=SIN(Y)*COS(Z)
+4540 ON K GOTO 1000,1010,1020:REM KEEP THIS LINE
+4550 POKE 768,N AND 255:S$=STR$(N)+CHR$(13)
+4560 IF A>B THEN A=B:PRINT TAB(10);"HELLO";
+4570 ON K GOTO 1000,1010,1020:Y=INT(RND(1)*100)
+4580 PRINT TAB(10);"HELLO";:ON K GOTO 1000,1010,1020
+4590 REM KEEP THIS LINE:ON K GOTO 1000,1010,1020
+4600 IF A>B THEN A=B:Y=INT(RND(1)*100)
+4610 FOR I=1 TO 10:T=T+I:NEXT I:ON K GOTO 1000,1010,1020
+4620 DIM Q(20):GOSUB 20000
+4630 REM KEEP THIS LINE:ON K GOTO 1000,1010,1020
+4640 IF A>B THEN A=B:GOSUB 20000
+4650 IF A>B THEN A=B:READ D:DATA 1,2,3
+4660 POKE 768,N AND 255:PRINT "TOTAL";T
+4670 S$=STR$(N)+CHR$(13):GOSUB 20000
+4680 POKE 768,N AND 255:GOSUB 20000
+4690 ON K GOTO 1000,1010,1020:DIM Q(20)
+4700 FOR I=1 TO 10:T=T+I:NEXT I:Y=INT(RND(1)*100)
+4710 A$=LEFT$(B$,3)+"X":PRINT TAB(10);"HELLO";
+4720 Y=INT(RND(1)*100):REM KEEP THIS LINE
+4730 X=SIN(Y)*COS(Z):IF A>B THEN A=B
+4740 REM KEEP THIS LINE:REM KEEP THIS LINE
+4750 PRINT "TOTAL";T:PRINT TAB(10);"HELLO";
+4760 X=SIN(Y)*COS(Z):REM KEEP THIS LINE
+4770 X=SIN(Y)*COS(Z):POKE 768,N AND 255
+4780 X=SIN(Y)*COS(Z):ON K GOTO 1000,1010,1020
+4790 PRINT TAB(10);"HELLO";:READ D:DATA 1,2,3
+4800 POKE 768,N AND 255:GOSUB 20000
+4810 PRINT TAB(10);"HELLO";:Y=INT(RND(1)*100)
+4820 PRINT TAB(10);"HELLO";:GOSUB 20000
+4830 POKE 768,N AND 255:GOSUB 20000
+4840 DIM Q(20):READ D:DATA 1,2,3
+4850 X=SIN(Y)*COS(Z):ON K GOTO 1000,1010,1020
+4860 READ D:DATA 1,2,3:X=SIN(Y)*COS(Z)
+4870 FOR I=1 TO 10:T=T+I:NEXT I:A$=LEFT$(B$,3)+"X"
+4880 POKE 768,N AND 255:GOSUB 20000
+4890 X=SIN(Y)*COS(Z):Y=INT(RND(1)*100)
+4900 REM KEEP THIS LINE:A$=LEFT$(B$,3)+"X"
+4910 POKE 768,N AND 255:IF A>B THEN A=B
+4920 Y=INT(RND(1)*100):PRINT "TOTAL";T
+4930 DIM Q(20):PRINT "TOTAL";T
+4940 X=SIN(Y)*COS(Z):ON K GOTO 1000,1010,1020
+4950 S$=STR$(N)+CHR$(13):S$=STR$(N)+CHR$(13)
+4960 X=SIN(Y)*COS(Z):READ D:DATA 1,2,3
+4970 S$=STR$(N)+CHR$(13):ON K GOTO 1000,1010,1020
+4980 IF A>B THEN A=B:DIM Q(20)
+4990 READ D:DATA 1,2,3:FOR I=1 TO 10:T=T+I:NEXT I
+5000 X=SIN(Y)*COS(Z):IF A>B THEN A=B
+5010 GOSUB 20000:ON K GOTO 1000,1010,1020
+5020 Y=INT(RND(1)*100):POKE 768,N AND 255
+5030 S$=STR$(N)+CHR$(13):PRINT "TOTAL";T
+5040 POKE 768,N AND 255:Y=INT(RND(1)*100)
+5050 ON K GOTO 1000,1010,1020:Y=INT(RND(1)*100)
+5060 Y=INT(RND(1)*100):REM KEEP THIS LINE
+5070 A$=LEFT$(B$,3)+"X":REM KEEP THIS LINE
+5080 X=SIN(Y)*COS(Z):FOR I=1 TO 10:T=T+I:NEXT I
+5090 A$=LEFT$(B$,3)+"X":READ D:DATA 1,2,3
+5100 IF A>B THEN A=B:PRINT "TOTAL";T
+5110 X=SIN(Y)*COS(Z):READ D:DATA 1,2,3
+5120 FOR I=1 TO 10:T=T+I:NEXT I:PRINT TAB(10);"HELLO";
+5130 ON K GOTO 1000,1010,1020:X=SIN(Y)*COS(Z)
+5140 S$=STR$(N)+CHR$(13):DIM Q(20)
+5150 X=SIN(Y)*COS(Z):ON K GOTO 1000,1010,1020
+5160 X=SIN(Y)*COS(Z):IF A>B THEN A=B
+5170 PRINT TAB(10);"HELLO";:GOSUB 20000
+5180 PRINT TAB(10);"HELLO";:REM KEEP THIS LINE
+5190 PRINT "TOTAL";T:PRINT TAB(10);"HELLO";
+5200 REM KEEP THIS LINE:ON K GOTO 1000,1010,1020
+5210 IF A>B THEN A=B:ON K GOTO 1000,1010,1020
+5220 FOR I=1 TO 10:T=T+I:NEXT I:A$=LEFT$(B$,3)+"X"
+5230 DIM Q(20):IF A>B THEN A=B
+5240 DIM Q(20):GOSUB 20000
+5250 S$=STR$(N)+CHR$(13):IF A>B THEN A=B
+5260 S$=STR$(N)+CHR$(13):GOSUB 20000
+5270 READ D:DATA 1,2,3:S$=STR$(N)+CHR$(13)
+5280 POKE 768,N AND 255:IF A>B THEN A=B
+5290 DIM Q(20):Y=INT(RND(1)*100)
+5300 PRINT TAB(10);"HELLO";:ON K GOTO 1000,1010,1020
+5310 S$=STR$(N)+CHR$(13):GOSUB 20000
+5320 X=SIN(Y)*COS(Z):POKE 768,N AND 255
+5330 ON K GOTO 1000,1010,1020:S$=STR$(N)+CHR$(13)
+5340 PRINT TAB(10);"HELLO";:READ D:DATA 1,2,3
+5350 ON K GOTO 1000,1010,1020:PRINT TAB(10);"HELLO";
+5360 GOSUB 20000:X=SIN(Y)*COS(Z)
+5370 ON K GOTO 1000,1010,1020:IF A>B THEN A=B
+5380 S$=STR$(N)+CHR$(13):ON K GOTO 1000,1010,1020
+5390 POKE 768,N AND 255:REM KEEP THIS LINE
+5400 Y=INT(RND(1)*100):X=SIN(Y)*COS(Z)
+5410 GOSUB 20000:A$=LEFT$(B$,3)+"X"
+5420 FOR I=1 TO 10:T=T+I:NEXT I:IF A>B THEN A=B
+5430 GOSUB 20000:X=SIN(Y)*COS(Z)
+5440 GOSUB 20000:REM KEEP THIS LINE
+5450 IF A>B THEN A=B:READ D:DATA 1,2,3
+5460 DIM Q(20):DIM Q(20)
+5470 FOR I=1 TO 10:T=T+I:NEXT I:PRINT "TOTAL";T
+5480 READ D:DATA 1,2,3:ON K GOTO 1000,1010,1020
+5490 A$=LEFT$(B$,3)+"X":ON K GOTO 1000,1010,1020
+5500 FOR I=1 TO 10:T=T+I:NEXT I:X=SIN(Y)*COS(Z)
+5510 REM KEEP THIS LINE:X=SIN(Y)*COS(Z)
+5520 S$=STR$(N)+CHR$(13):FOR I=1 TO 10:T=T+I:NEXT I
+5530 READ D:DATA 1,2,3:A$=LEFT$(B$,3)+"X"
+5540 ON K GOTO 1000,1010,1020:IF A>B THEN A=B
+5550 READ D:DATA 1,2,3:FOR I=1 TO 10:T=T+I:NEXT I
+5560 POKE 768,N AND 255:GOSUB 20000
+5570 PRINT TAB(10);"HELLO";:PRINT "TOTAL";T
+5580 REM KEEP THIS LINE:Y=INT(RND(1)*100)
+5590 DIM Q(20):PRINT "TOTAL";T
+5600 Y=INT(RND(1)*100):DIM Q(20)
+5610 S$=STR$(N)+CHR$(13):FOR I=1 TO 10:T=T+I:NEXT I
+5620 S$=STR$(N)+CHR$(13):READ D:DATA 1,2,3
+5630 FOR I=1 TO 10:T=T+I:NEXT I:POKE 768,N AND 255
+5640 A$=LEFT$(B$,3)+"X":Y=INT(RND(1)*100)
+5650 ON K GOTO 1000,1010,1020:IF A>B THEN A=B
+5660 IF A>B THEN A=B:FOR I=1 TO 10:T=T+I:NEXT I
+5670 X=SIN(Y)*COS(Z):PRINT TAB(10);"HELLO";
+5680 ON K GOTO 1000,1010,1020:PRINT "TOTAL";T
+5690 GOSUB 20000:REM KEEP THIS LINE
+5700 ON K GOTO 1000,1010,1020:Y=INT(RND(1)*100)
+5710 DIM Q(20):PRINT TAB(10);"HELLO";
+5720 DIM Q(20):IF A>B THEN A=B
+5730 PRINT TAB(10);"HELLO";:IF A>B THEN A=B
+5740 PRINT TAB(10);"HELLO";:DIM Q(20)
+5750 Y=INT(RND(1)*100):READ D:DATA 1,2,3
+5760 PRINT TAB(10);"HELLO";:PRINT TAB(10);"HELLO";
+5770 A$=LEFT$(B$,3)+"X":READ D:DATA 1,2,3
+5780 DIM Q(20):Y=INT(RND(1)*100)
+5790 FOR I=1 TO 10:T=T+I:NEXT I:READ D:DATA 1,2,3
+5800 S$=STR$(N)+CHR$(13):GOSUB 20000
+5810 PRINT TAB(10);"HELLO";:S$=STR$(N)+CHR$(13)
+5820 X=SIN(Y)*COS(Z):IF A>B THEN A=B
+5830 X=SIN(Y)*COS(Z):PRINT "TOTAL";T
+5840 REM KEEP THIS LINE:FOR I=1 TO 10:T=T+I:NEXT I
+5850 IF A>B THEN A=B:REM KEEP THIS LINE
+5860 X=SIN(Y)*COS(Z):X=SIN(Y)*COS(Z)
+5870 PRINT "TOTAL";T:ON K GOTO 1000,1010,1020
+5880 READ D:DATA 1,2,3:PRINT "TOTAL";T
+5890 X=SIN(Y)*COS(Z):A$=LEFT$(B$,3)+"X"
+5900 POKE 768,N AND 255:S$=STR$(N)+CHR$(13)
+5910 POKE 768,N AND 255:PRINT TAB(10);"HELLO";
+5920 FOR I=1 TO 10:T=T+I:NEXT I:Y=INT(RND(1)*100)
+5930 DIM Q(20):GOSUB 20000
+5940 DIM Q(20):ON K GOTO 1000,1010,1020
+5950 REM KEEP THIS LINE:REM KEEP THIS LINE
+5960 POKE 768,N AND 255:A$=LEFT$(B$,3)+"X"
+5970 FOR I=1 TO 10:T=T+I:NEXT I:S$=STR$(N)+CHR$(13)
+5980 A$=LEFT$(B$,3)+"X":Y=INT(RND(1)*100)
+5990 PRINT "TOTAL";T:ON K GOTO 1000,1010,1020
+6000 PRINT TAB(10);"HELLO";:PRINT TAB(10);"HELLO";
+6010 READ D:DATA 1,2,3:GOSUB 20000
+6020 GOSUB 20000:GOSUB 20000
+6030 Y=INT(RND(1)*100):PRINT TAB(10);"HELLO";
+6040 REM KEEP THIS LINE:IF A>B THEN A=B
+6050 ON K GOTO 1000,1010,1020:Y=INT(RND(1)*100)
+6060 PRINT TAB(10);"HELLO";:S$=STR$(N)+CHR$(13)
+6070 GOSUB 20000:REM KEEP THIS LINE
+6080 REM KEEP THIS LINE:REM KEEP THIS LINE
+6090 DIM Q(20):IF A>B THEN A=B
+6100 GOSUB 20000:X=SIN(Y)*COS(Z)
+6110 POKE 768,N AND 255:GOSUB 20000
+6120 Y=INT(RND(1)*100):FOR I=1 TO 10:T=T+I:NEXT I
+6130 Y=INT(RND(1)*100):DIM Q(20)
+6140 A$=LEFT$(B$,3)+"X":GOSUB 20000
+6150 Y=INT(RND(1)*100):S$=STR$(N)+CHR$(13)
+6160 POKE 768,N AND 255:READ D:DATA 1,2,3
+6170 PRINT "TOTAL";T:PRINT TAB(10);"HELLO";
+6180 FOR I=1 TO 10:T=T+I:NEXT I:REM KEEP THIS LINE
+6190 A$=LEFT$(B$,3)+"X":ON K GOTO 1000,1010,1020
+6200 S$=STR$(N)+CHR$(13):READ D:DATA 1,2,3
+6210 PRINT "TOTAL";T:ON K GOTO 1000,1010,1020
+6220 REM KEEP THIS LINE:DIM Q(20)
+6230 PRINT TAB(10);"HELLO";:DIM Q(20)
+6240 GOSUB 20000:DIM Q(20)
+6250 POKE 768,N AND 255:X=SIN(Y)*COS(Z)
+6260 PRINT TAB(10);"HELLO";:POKE 768,N AND 255
+6270 PRINT TAB(10);"HELLO";:S$=STR$(N)+CHR$(13)
+6280 POKE 768,N AND 255:DIM Q(20)
+6290 A$=LEFT$(B$,3)+"X":IF A>B THEN A=B
+6300 FOR I=1 TO 10:T=T+I:NEXT I:PRINT "TOTAL";T
+6310 REM KEEP THIS LINE:READ D:DATA 1,2,3
+6320 DIM Q(20):ON K GOTO 1000,1010,1020
+6330 GOSUB 20000:FOR I=1 TO 10:T=T+I:NEXT I
+6340 DIM Q(20):REM KEEP THIS LINE
+6350 READ D:DATA 1,2,3:Y=INT(RND(1)*100)
+6360 A$=LEFT$(B$,3)+"X":GOSUB 20000
+6370 PRINT TAB(10);"HELLO";:ON K GOTO 1000,1010,1020
+6380 GOSUB 20000:GOSUB 20000
+6390 REM KEEP THIS LINE:DIM Q(20)
+6400 REM KEEP THIS LINE:READ D:DATA 1,2,3
+6410 X=SIN(Y)*COS(Z):DIM Q(20)
+6420 REM KEEP THIS LINE:A$=LEFT$(B$,3)+"X"
+6430 DIM Q(20):FOR I=1 TO 10:T=T+I:NEXT I
+6440 PRINT "TOTAL";T:FOR I=1 TO 10:T=T+I:NEXT I
+6450 Y=INT(RND(1)*100):S$=STR$(N)+CHR$(13)
+6460 DIM Q(20):DIM Q(20)
+6470 X=SIN(Y)*COS(Z):REM KEEP THIS LINE
+6480 A$=LEFT$(B$,3)+"X":GOSUB 20000
+6490 Y=INT(RND(1)*100):POKE 768,N AND 255
+6500 IF A>B THEN A=B:REM KEEP THIS LINE
+6510 PRINT "TOTAL";T:S$=STR$(N)+CHR$(13)
+6520 POKE 768,N AND 255:READ D:DATA 1,2,3
+6530 Y=INT(RND(1)*100):PRINT "TOTAL";T
+6540 POKE 768,N AND 255:PRINT TAB(10);"HELLO";
+6550 IF A>B THEN A=B:PRINT "TOTAL";T
+6560 ON K GOTO 1000,1010,1020:A$=LEFT$(B$,3)+"X"
+6570 FOR I=1 TO 10:T=T+I:NEXT I:READ D:DATA 1,2,3
+6580 PRINT "TOTAL";T:IF A>B THEN A=B
+6590 REM KEEP THIS LINE:PRINT TAB(10);"HELLO";
+6600 PRINT TAB(10);"HELLO";:A$=LEFT$(B$,3)+"X"
+6610 FOR I=1 TO 10:T=T+I:NEXT I:IF A>B THEN A=B
+6620 A$=LEFT$(B$,3)+"X":X=SIN(Y)*COS(Z)
+6630 A$=LEFT$(B$,3)+"X":ON K GOTO 1000,1010,1020
+6640 FOR I=1 TO 10:T=T+I:NEXT I:Y=INT(RND(1)*100)
+6650 POKE 768,N AND 255:READ D:DATA 1,2,3
+6660 PRINT TAB(10);"HELLO";:X=SIN(Y)*COS(Z)
+6670 GOSUB 20000:READ D:DATA 1,2,3
+6680 S$=STR$(N)+CHR$(13):S$=STR$(N)+CHR$(13)
+6690 POKE 768,N AND 255:PRINT "TOTAL";T
+6700 S$=STR$(N)+CHR$(13):PRINT TAB(10);"HELLO";
+6710 PRINT TAB(10);"HELLO";:PRINT "TOTAL";T
+6720 READ D:DATA 1,2,3:POKE 768,N AND 255
+6730 PRINT TAB(10);"HELLO";:S$=STR$(N)+CHR$(13)
+6740 FOR I=1 TO 10:T=T+I:NEXT I:POKE 768,N AND 255
+6750 A$=LEFT$(B$,3)+"X":PRINT "TOTAL";T
+6760 PRINT TAB(10);"HELLO";:POKE 768,N AND 255
+6770 GOSUB 20000:A$=LEFT$(B$,3)+"X"
+6780 S$=STR$(N)+CHR$(13):DIM Q(20)
+6790 FOR I=1 TO 10:T=T+I:NEXT I:S$=STR$(N)+CHR$(13)
+6800 S$=STR$(N)+CHR$(13):DIM Q(20)
+6810 FOR I=1 TO 10:T=T+I:NEXT I:DIM Q(20)
+6820 S$=STR$(N)+CHR$(13):S$=STR$(N)+CHR$(13)
+6830 A$=LEFT$(B$,3)+"X":Y=INT(RND(1)*100)
+6840 REM KEEP THIS LINE:X=SIN(Y)*COS(Z)
+6850 PRINT "TOTAL";T:PRINT "TOTAL";T
+6860 DIM Q(20):REM KEEP THIS LINE
+6870 FOR I=1 TO 10:T=T+I:NEXT I:X=SIN(Y)*COS(Z)
+6880 FOR I=1 TO 10:T=T+I:NEXT I:A$=LEFT$(B$,3)+"X"
+6890 S$=STR$(N)+CHR$(13):Y=INT(RND(1)*100)
+6900 FOR I=1 TO 10:T=T+I:NEXT I:IF A>B THEN A=B
+6910 REM KEEP THIS LINE:GOSUB 20000
+6920 PRINT TAB(10);"HELLO";:PRINT "TOTAL";T
+6930 DIM Q(20):FOR I=1 TO 10:T=T+I:NEXT I
+6940 PRINT TAB(10);"HELLO";:REM KEEP THIS LINE
+6950 ON K GOTO 1000,1010,1020:REM KEEP THIS LINE
+6960 DIM Q(20):S$=STR$(N)+CHR$(13)
+6970 ON K GOTO 1000,1010,1020:POKE 768,N AND 255
+6980 A$=LEFT$(B$,3)+"X":S$=STR$(N)+CHR$(13)
+6990 POKE 768,N AND 255:S$=STR$(N)+CHR$(13)
+7000 READ D:DATA 1,2,3:FOR I=1 TO 10:T=T+I:NEXT I
+7010 PRINT "TOTAL";T:IF A>B THEN A=B
+7020 REM KEEP THIS LINE:S$=STR$(N)+CHR$(13)
+7030 S$=STR$(N)+CHR$(13):PRINT TAB(10);"HELLO";
+7040 GOSUB 20000:PRINT "TOTAL";T
+7050 DIM Q(20):PRINT "TOTAL";T
+7060 PRINT TAB(10);"HELLO";:DIM Q(20)
+7070 PRINT TAB(10);"HELLO";:ON K GOTO 1000,1010,1020
+7080 X=SIN(Y)*COS(Z):GOSUB 20000
+7090 PRINT TAB(10);"HELLO";:Y=INT(RND(1)*100)
+7100 DIM Q(20):PRINT TAB(10);"HELLO";
+7110 DIM Q(20):PRINT "TOTAL";T
+7120 ON K GOTO 1000,1010,1020:DIM Q(20)
+7130 Y=INT(RND(1)*100):IF A>B THEN A=B
+7140 DIM Q(20):FOR I=1 TO 10:T=T+I:NEXT I
+7150 IF A>B THEN A=B:GOSUB 20000
+7160 GOSUB 20000:A$=LEFT$(B$,3)+"X"
+7170 PRINT TAB(10);"HELLO";:DIM Q(20)
+7180 GOSUB 20000:PRINT "TOTAL";T
+7190 A$=LEFT$(B$,3)+"X":PRINT TAB(10);"HELLO";
+7200 READ D:DATA 1,2,3:ON K GOTO 1000,1010,1020
+7210 READ D:DATA 1,2,3:POKE 768,N AND 255
+7220 A$=LEFT$(B$,3)+"X":S$=STR$(N)+CHR$(13)
+7230 PRINT TAB(10);"HELLO";:IF A>B THEN A=B
+7240 A$=LEFT$(B$,3)+"X":POKE 768,N AND 255
+7250 PRINT "TOTAL";T:READ D:DATA 1,2,3
+7260 Y=INT(RND(1)*100):FOR I=1 TO 10:T=T+I:NEXT I
+7270 S$=STR$(N)+CHR$(13):IF A>B THEN A=B
+7280 REM KEEP THIS LINE:POKE 768,N AND 255
+7290 PRINT TAB(10);"HELLO";:GOSUB 20000
+7300 Y=INT(RND(1)*100):DIM Q(20)
+7310 S$=STR$(N)+CHR$(13):Y=INT(RND(1)*100)
+7320 DIM Q(20):POKE 768,N AND 255
+7330 A$=LEFT$(B$,3)+"X":PRINT "TOTAL";T
+7340 FOR I=1 TO 10:T=T+I:NEXT I:A$=LEFT$(B$,3)+"X"
+7350 PRINT TAB(10);"HELLO";:Y=INT(RND(1)*100)
+7360 POKE 768,N AND 255:S$=STR$(N)+CHR$(13)
+7370 IF A>B THEN A=B:REM KEEP THIS LINE
+7380 X=SIN(Y)*COS(Z):S$=STR$(N)+CHR$(13)
+7390 S$=STR$(N)+CHR$(13):FOR I=1 TO 10:T=T+I:NEXT I
+7400 FOR I=1 TO 10:T=T+I:NEXT I:ON K GOTO 1000,1010,1020
+7410 FOR I=1 TO 10:T=T+I:NEXT I:POKE 768,N AND 255
+7420 PRINT TAB(10);"HELLO";:POKE 768,N AND 255
+7430 PRINT TAB(10);"HELLO";:FOR I=1 TO 10:T=T+I:NEXT I
+7440 FOR I=1 TO 10:T=T+I:NEXT I:FOR I=1 TO 10:T=T+I:NEXT I
+7450 REM KEEP THIS LINE:PRINT "TOTAL";T
+7460 REM KEEP THIS LINE:Y=INT(RND(1)*100)
+7470 Y=INT(RND(1)*100):REM KEEP THIS LINE
+7480 READ D:DATA 1,2,3:X=SIN(Y)*COS(Z)
+7490 DIM Q(20):GOSUB 20000
+7500 IF A>B THEN A=B:ON K GOTO 1000,1010,1020
+7510 REM KEEP THIS LINE:POKE 768,N AND 255
+7520 S$=STR$(N)+CHR$(13):X=SIN(Y)*COS(Z)
+7530 GOSUB 20000:PRINT "TOTAL";T
+7540 A$=LEFT$(B$,3)+"X":READ D:DATA 1,2,3
+7550 PRINT TAB(10);"HELLO";:POKE 768,N AND 255
+7560 IF A>B THEN A=B:DIM Q(20)
+7570 ON K GOTO 1000,1010,1020:DIM Q(20)
+7580 GOSUB 20000:X=SIN(Y)*COS(Z)
+7590 ON K GOTO 1000,1010,1020:DIM Q(20)
+7600 S$=STR$(N)+CHR$(13):A$=LEFT$(B$,3)+"X"
+7610 PRINT "TOTAL";T:S$=STR$(N)+CHR$(13)
+7620 FOR I=1 TO 10:T=T+I:NEXT I:FOR I=1 TO 10:T=T+I:NEXT I
+7630 PRINT "TOTAL";T:READ D:DATA 1,2,3
+7640 X=SIN(Y)*COS(Z):S$=STR$(N)+CHR$(13)
+7650 IF A>B THEN A=B:READ D:DATA 1,2,3
+7660 DIM Q(20):Y=INT(RND(1)*100)
+7670 ON K GOTO 1000,1010,1020:READ D:DATA 1,2,3
+7680 IF A>B THEN A=B:READ D:DATA 1,2,3
+7690 DIM Q(20):GOSUB 20000
+7700 Y=INT(RND(1)*100):S$=STR$(N)+CHR$(13)
+7710 X=SIN(Y)*COS(Z):X=SIN(Y)*COS(Z)
+7720 READ D:DATA 1,2,3:PRINT TAB(10);"HELLO";
+7730 FOR I=1 TO 10:T=T+I:NEXT I:ON K GOTO 1000,1010,1020
+7740 PRINT "TOTAL";T:REM KEEP THIS LINE
+7750 A$=LEFT$(B$,3)+"X":DIM Q(20)
+7760 DIM Q(20):POKE 768,N AND 255
+7770 X=SIN(Y)*COS(Z):IF A>B THEN A=B
+7780 A$=LEFT$(B$,3)+"X":PRINT "TOTAL";T
+7790 ON K GOTO 1000,1010,1020:X=SIN(Y)*COS(Z)
+7800 DIM Q(20):Y=INT(RND(1)*100)
+7810 S$=STR$(N)+CHR$(13):PRINT "TOTAL";T
+7820 PRINT TAB(10);"HELLO";:REM KEEP THIS LINE
+7830 A$=LEFT$(B$,3)+"X":S$=STR$(N)+CHR$(13)
+7840 DIM Q(20):PRINT "TOTAL";T
+7850 GOSUB 20000:PRINT "TOTAL";T
+7860 POKE 768,N AND 255:POKE 768,N AND 255
+7870 PRINT TAB(10);"HELLO";:PRINT "TOTAL";T
+7880 A$=LEFT$(B$,3)+"X":A$=LEFT$(B$,3)+"X"
+7890 ON K GOTO 1000,1010,1020:DIM Q(20)
+7900 REM KEEP THIS LINE:PRINT "TOTAL";T
+7910 POKE 768,N AND 255:FOR I=1 TO 10:T=T+I:NEXT I
+7920 GOSUB 20000:READ D:DATA 1,2,3
+7930 POKE 768,N AND 255:FOR I=1 TO 10:T=T+I:NEXT I
+7940 IF A>B THEN A=B:IF A>B THEN A=B
+7950 X=SIN(Y)*COS(Z):FOR I=1 TO 10:T=T+I:NEXT I
+7960 ON K GOTO 1000,1010,1020:Y=INT(RND(1)*100)
+7970 PRINT "TOTAL";T:X=SIN(Y)*COS(Z)
+7980 ON K GOTO 1000,1010,1020:REM KEEP THIS LINE
+7990 ON K GOTO 1000,1010,1020:X=SIN(Y)*COS(Z)
+8000 DIM Q(20):DIM Q(20)
+8010 A$=LEFT$(B$,3)+"X":PRINT TAB(10);"HELLO";
+8020 A$=LEFT$(B$,3)+"X":FOR I=1 TO 10:T=T+I:NEXT I
+8030 READ D:DATA 1,2,3:ON K GOTO 1000,1010,1020
+8040 GOSUB 20000:GOSUB 20000
+8050 IF A>B THEN A=B:X=SIN(Y)*COS(Z)
+8060 GOSUB 20000:S$=STR$(N)+CHR$(13)
+8070 POKE 768,N AND 255:PRINT TAB(10);"HELLO";
+8080 PRINT "TOTAL";T:A$=LEFT$(B$,3)+"X"
+8090 FOR I=1 TO 10:T=T+I:NEXT I:S$=STR$(N)+CHR$(13)
+8100 PRINT TAB(10);"HELLO";:PRINT TAB(10);"HELLO";
+8110 A$=LEFT$(B$,3)+"X":Y=INT(RND(1)*100)
+8120 X=SIN(Y)*COS(Z):POKE 768,N AND 255
+8130 PRINT TAB(10);"HELLO";:READ D:DATA 1,2,3
+8140 POKE 768,N AND 255:PRINT "TOTAL";T
+8150 Y=INT(RND(1)*100):IF A>B THEN A=B
+8160 POKE 768,N AND 255:S$=STR$(N)+CHR$(13)
+8170 IF A>B THEN A=B:IF A>B THEN A=B
+8180 FOR I=1 TO 10:T=T+I:NEXT I:FOR I=1 TO 10:T=T+I:NEXT I
+8190 DIM Q(20):Y=INT(RND(1)*100)
+8200 POKE 768,N AND 255:POKE 768,N AND 255
+8210 IF A>B THEN A=B:X=SIN(Y)*COS(Z)
+8220 POKE 768,N AND 255:S$=STR$(N)+CHR$(13)
+8230 GOSUB 20000:A$=LEFT$(B$,3)+"X"
+8240 X=SIN(Y)*COS(Z):X=SIN(Y)*COS(Z)
+8250 DIM Q(20):X=SIN(Y)*COS(Z)
+8260 IF A>B THEN A=B:READ D:DATA 1,2,3
+8270 ON K GOTO 1000,1010,1020:A$=LEFT$(B$,3)+"X"
+8280 POKE 768,N AND 255:A$=LEFT$(B$,3)+"X"
+8290 S$=STR$(N)+CHR$(13):REM KEEP THIS LINE
+8300 IF A>B THEN A=B:Y=INT(RND(1)*100)
+8310 Y=INT(RND(1)*100):Y=INT(RND(1)*100)
+8320 DIM Q(20):Y=INT(RND(1)*100)
+8330 X=SIN(Y)*COS(Z):Y=INT(RND(1)*100)
+8340 Y=INT(RND(1)*100):READ D:DATA 1,2,3
+8350 ON K GOTO 1000,1010,1020:POKE 768,N AND 255
+8360 A$=LEFT$(B$,3)+"X":READ D:DATA 1,2,3
+8370 PRINT TAB(10);"HELLO";:X=SIN(Y)*COS(Z)
+8380 FOR I=1 TO 10:T=T+I:NEXT I:A$=LEFT$(B$,3)+"X"
+8390 READ D:DATA 1,2,3:FOR I=1 TO 10:T=T+I:NEXT I
+8400 IF A>B THEN A=B:Y=INT(RND(1)*100)
+8410 PRINT TAB(10);"HELLO";:IF A>B THEN A=B
+8420 READ D:DATA 1,2,3:REM KEEP THIS LINE
+8430 A$=LEFT$(B$,3)+"X":X=SIN(Y)*COS(Z)
+8440 DIM Q(20):Y=INT(RND(1)*100)
+8450 ON K GOTO 1000,1010,1020:POKE 768,N AND 255
+8460 Y=INT(RND(1)*100):REM KEEP THIS LINE
+8470 Y=INT(RND(1)*100):REM KEEP THIS LINE
+8480 GOSUB 20000:FOR I=1 TO 10:T=T+I:NEXT I
+8490 Y=INT(RND(1)*100):REM KEEP THIS LINE
+8500 A$=LEFT$(B$,3)+"X":S$=STR$(N)+CHR$(13)
+8510 READ D:DATA 1,2,3:IF A>B THEN A=B
+8520 A$=LEFT$(B$,3)+"X":READ D:DATA 1,2,3
+8530 READ D:DATA 1,2,3:DIM Q(20)
+8540 PRINT TAB(10);"HELLO";:A$=LEFT$(B$,3)+"X"
+8550 A$=LEFT$(B$,3)+"X":POKE 768,N AND 255
+8560 REM KEEP THIS LINE:PRINT TAB(10);"HELLO";
+8570 X=SIN(Y)*COS(Z):GOSUB 20000
+8580 S$=STR$(N)+CHR$(13):REM KEEP THIS LINE
+8590 IF A>B THEN A=B:FOR I=1 TO 10:T=T+I:NEXT I
+8600 READ D:DATA 1,2,3:DIM Q(20)
+8610 PRINT "TOTAL";T:FOR I=1 TO 10:T=T+I:NEXT I
+8620 FOR I=1 TO 10:T=T+I:NEXT I:S$=STR$(N)+CHR$(13)
+8630 POKE 768,N AND 255:DIM Q(20)
+8640 POKE 768,N AND 255:FOR I=1 TO 10:T=T+I:NEXT I
+8650 POKE 768,N AND 255:PRINT TAB(10);"HELLO";
+8660 S$=STR$(N)+CHR$(13):S$=STR$(N)+CHR$(13)
+8670 Y=INT(RND(1)*100):ON K GOTO 1000,1010,1020
+8680 ON K GOTO 1000,1010,1020:POKE 768,N AND 255
+8690 REM KEEP THIS LINE:FOR I=1 TO 10:T=T+I:NEXT I
+8700 ON K GOTO 1000,1010,1020:FOR I=1 TO 10:T=T+I:NEXT I
+8710 POKE 768,N AND 255:IF A>B THEN A=B
+8720 REM KEEP THIS LINE:X=SIN(Y)*COS(Z)
+8730 DIM Q(20):PRINT TAB(10);"HELLO";
+8740 ON K GOTO 1000,1010,1020:X=SIN(Y)*COS(Z)
+8750 REM KEEP THIS LINE:FOR I=1 TO 10:T=T+I:NEXT I
+8760 REM KEEP THIS LINE:A$=LEFT$(B$,3)+"X"
+8770 PRINT TAB(10);"HELLO";:S$=STR$(N)+CHR$(13)
+8780 A$=LEFT$(B$,3)+"X":ON K GOTO 1000,1010,1020
+8790 POKE 768,N AND 255:ON K GOTO 1000,1010,1020
+8800 Y=INT(RND(1)*100):S$=STR$(N)+CHR$(13)
+8810 A$=LEFT$(B$,3)+"X":S$=STR$(N)+CHR$(13)
+8820 GOSUB 20000:READ D:DATA 1,2,3
+8830 READ D:DATA 1,2,3:S$=STR$(N)+CHR$(13)
+8840 GOSUB 20000:IF A>B THEN A=B
+8850 POKE 768,N AND 255:Y=INT(RND(1)*100)
+8860 IF A>B THEN A=B:ON K GOTO 1000,1010,1020
+8870 IF A>B THEN A=B:POKE 768,N AND 255
+8880 A$=LEFT$(B$,3)+"X":GOSUB 20000
+8890 PRINT TAB(10);"HELLO";:Y=INT(RND(1)*100)
+8900 POKE 768,N AND 255:ON K GOTO 1000,1010,1020
+8910 POKE 768,N AND 255:S$=STR$(N)+CHR$(13)
+8920 Y=INT(RND(1)*100):X=SIN(Y)*COS(Z)
+8930 IF A>B THEN A=B:ON K GOTO 1000,1010,1020
+8940 REM KEEP THIS LINE:PRINT "TOTAL";T
+8950 S$=STR$(N)+CHR$(13):GOSUB 20000
+8960 A$=LEFT$(B$,3)+"X":X=SIN(Y)*COS(Z)
+8970 ON K GOTO 1000,1010,1020:IF A>B THEN A=B
+8980 PRINT TAB(10);"HELLO";:READ D:DATA 1,2,3
+8990 PRINT TAB(10);"HELLO";:PRINT TAB(10);"HELLO";
+9000 S$=STR$(N)+CHR$(13):FOR I=1 TO 10:T=T+I:NEXT I
+9010 REM KEEP THIS LINE:X=SIN(Y)*COS(Z)
+9020 FOR I=1 TO 10:T=T+I:NEXT I:S$=STR$(N)+CHR$(13)
+9030 S$=STR$(N)+CHR$(13):A$=LEFT$(B$,3)+"X"
+9040 GOSUB 20000:POKE 768,N AND 255
+9050 S$=STR$(N)+CHR$(13):GOSUB 20000
+9060 REM KEEP THIS LINE:READ D:DATA 1,2,3
+9070 PRINT TAB(10);"HELLO";:DIM Q(20)
+9080 REM KEEP THIS LINE:FOR I=1 TO 10:T=T+I:NEXT I
+9090 Y=INT(RND(1)*100):GOSUB 20000
+9100 GOSUB 20000:Y=INT(RND(1)*100)
+9110 IF A>B THEN A=B:GOSUB 20000
+9120 IF A>B THEN A=B:Y=INT(RND(1)*100)
+9130 A$=LEFT$(B$,3)+"X":IF A>B THEN A=B
+9140 POKE 768,N AND 255:FOR I=1 TO 10:T=T+I:NEXT I
+9150 FOR I=1 TO 10:T=T+I:NEXT I:POKE 768,N AND 255
+9160 IF A>B THEN A=B:X=SIN(Y)*COS(Z)
+9170 FOR I=1 TO 10:T=T+I:NEXT I:IF A>B THEN A=B
+9180 POKE 768,N AND 255:FOR I=1 TO 10:T=T+I:NEXT I
+9190 PRINT TAB(10);"HELLO";:X=SIN(Y)*COS(Z)
+9200 FOR I=1 TO 10:T=T+I:NEXT I:GOSUB 20000
+9210 POKE 768,N AND 255:X=SIN(Y)*COS(Z)
+9220 POKE 768,N AND 255:DIM Q(20)
+9230 READ D:DATA 1,2,3:FOR I=1 TO 10:T=T+I:NEXT I
+9240 PRINT "TOTAL";T:FOR I=1 TO 10:T=T+I:NEXT I
+9250 POKE 768,N AND 255:X=SIN(Y)*COS(Z)
+9260 REM KEEP THIS LINE:A$=LEFT$(B$,3)+"X"
+9270 POKE 768,N AND 255:IF A>B THEN A=B
+9280 ON K GOTO 1000,1010,1020:REM KEEP THIS LINE
+9290 PRINT "TOTAL";T:FOR I=1 TO 10:T=T+I:NEXT I
+9300 PRINT "TOTAL";T:PRINT "TOTAL";T
+9310 X=SIN(Y)*COS(Z):PRINT "TOTAL";T
+9320 PRINT "TOTAL";T:Y=INT(RND(1)*100)
+9330 FOR I=1 TO 10:T=T+I:NEXT I:A$=LEFT$(B$,3)+"X"
+9340 PRINT TAB(10);"HELLO";:X=SIN(Y)*COS(Z)
+9350 PRINT "TOTAL";T:X=SIN(Y)*COS(Z)
+9360 ON K GOTO 1000,1010,1020:READ D:DATA 1,2,3
+9370 PRINT TAB(10);"HELLO";:PRINT "TOTAL";T
+9380 POKE 768,N AND 255:PRINT TAB(10);"HELLO";
+9390 ON K GOTO 1000,1010,1020:GOSUB 20000
+9400 PRINT TAB(10);"HELLO";:Y=INT(RND(1)*100)
+9410 DIM Q(20):Y=INT(RND(1)*100)
+9420 Y=INT(RND(1)*100):ON K GOTO 1000,1010,1020
+9430 READ D:DATA 1,2,3:ON K GOTO 1000,1010,1020
+9440 IF A>B THEN A=B:X=SIN(Y)*COS(Z)
+9450 DIM Q(20):Y=INT(RND(1)*100)
+9460 PRINT "TOTAL";T:S$=STR$(N)+CHR$(13)
+9470 PRINT TAB(10);"HELLO";:A$=LEFT$(B$,3)+"X"
+9480 POKE 768,N AND 255:GOSUB 20000
+9490 PRINT TAB(10);"HELLO";:Y=INT(RND(1)*100)
+9500 GOSUB 20000:Y=INT(RND(1)*100)
+9510 PRINT "TOTAL";T:X=SIN(Y)*COS(Z)
+9520 DIM Q(20):ON K GOTO 1000,1010,1020
+9530 FOR I=1 TO 10:T=T+I:NEXT I:Y=INT(RND(1)*100)
+9540 Y=INT(RND(1)*100):ON K GOTO 1000,1010,1020
+9550 ON K GOTO 1000,1010,1020:PRINT TAB(10);"HELLO";
+9560 ON K GOTO 1000,1010,1020:Y=INT(RND(1)*100)
+9570 PRINT "TOTAL";T:REM KEEP THIS LINE
+9580 PRINT "TOTAL";T:A$=LEFT$(B$,3)+"X"
+9590 REM KEEP THIS LINE:GOSUB 20000
+9600 A$=LEFT$(B$,3)+"X":X=SIN(Y)*COS(Z)
+9610 PRINT "TOTAL";T:A$=LEFT$(B$,3)+"X"
+9620 READ D:DATA 1,2,3:IF A>B THEN A=B
+9630 PRINT TAB(10);"HELLO";:GOSUB 20000
+9640 IF A>B THEN A=B:PRINT "TOTAL";T
+9650 POKE 768,N AND 255:A$=LEFT$(B$,3)+"X"
+9660 PRINT TAB(10);"HELLO";:DIM Q(20)
+9670 IF A>B THEN A=B:S$=STR$(N)+CHR$(13)
+9680 GOSUB 20000:A$=LEFT$(B$,3)+"X"
+9690 DIM Q(20):A$=LEFT$(B$,3)+"X"
+9700 PRINT TAB(10);"HELLO";:A$=LEFT$(B$,3)+"X"
+9710 GOSUB 20000:A$=LEFT$(B$,3)+"X"
+9720 DIM Q(20):S$=STR$(N)+CHR$(13)
+9730 S$=STR$(N)+CHR$(13):GOSUB 20000
+9740 GOSUB 20000:A$=LEFT$(B$,3)+"X"
+9750 ON K GOTO 1000,1010,1020:PRINT "TOTAL";T
+9760 READ D:DATA 1,2,3:PRINT "TOTAL";T
+9770 PRINT TAB(10);"HELLO";:PRINT TAB(10);"HELLO";
+9780 A$=LEFT$(B$,3)+"X":X=SIN(Y)*COS(Z)
+9790 PRINT "TOTAL";T:Y=INT(RND(1)*100)
+9800 REM KEEP THIS LINE:FOR I=1 TO 10:T=T+I:NEXT I
+9810 PRINT TAB(10);"HELLO";:S$=STR$(N)+CHR$(13)
+9820 IF A>B THEN A=B:A$=LEFT$(B$,3)+"X"
+9830 Y=INT(RND(1)*100):IF A>B THEN A=B
+9840 GOSUB 20000:FOR I=1 TO 10:T=T+I:NEXT I
+9850 X=SIN(Y)*COS(Z):IF A>B THEN A=B
+9860 PRINT TAB(10);"HELLO";:A$=LEFT$(B$,3)+"X"
+9870 FOR I=1 TO 10:T=T+I:NEXT I:FOR I=1 TO 10:T=T+I:NEXT I
+9880 POKE 768,N AND 255:IF A>B THEN A=B
+9890 REM KEEP THIS LINE:Y=INT(RND(1)*100)
+9900 IF A>B THEN A=B:Y=INT(RND(1)*100)
+9910 DIM Q(20):ON K GOTO 1000,1010,1020
+9920 A$=LEFT$(B$,3)+"X":FOR I=1 TO 10:T=T+I:NEXT I
+9930 PRINT TAB(10);"HELLO";:IF A>B THEN A=B
+9940 A$=LEFT$(B$,3)+"X":REM KEEP THIS LINE
+9950 A$=LEFT$(B$,3)+"X":PRINT "TOTAL";T
+9960 PRINT TAB(10);"HELLO";:A$=LEFT$(B$,3)+"X"
+9970 DIM Q(20):PRINT "TOTAL";T
+9980 A$=LEFT$(B$,3)+"X":ON K GOTO 1000,1010,1020
+9990 POKE 768,N AND 255:FOR I=1 TO 10:T=T+I:NEXT I
+10000 Y=INT(RND(1)*100):REM KEEP THIS LINE
+10010 Y=INT(RND(1)*100):PRINT TAB(10);"HELLO";
+10020 A$=LEFT$(B$,3)+"X":A$=LEFT$(B$,3)+"X"
+10030 X=SIN(Y)*COS(Z):X=SIN(Y)*COS(Z)
+10040 READ D:DATA 1,2,3:FOR I=1 TO 10:T=T+I:NEXT I
+10050 A$=LEFT$(B$,3)+"X":READ D:DATA 1,2,3
+10060 PRINT "TOTAL";T:READ D:DATA 1,2,3
+10070 IF A>B THEN A=B:POKE 768,N AND 255
+10080 FOR I=1 TO 10:T=T+I:NEXT I:ON K GOTO 1000,1010,1020
+10090 GOSUB 20000:GOSUB 20000
+10100 GOSUB 20000:X=SIN(Y)*COS(Z)
+10110 X=SIN(Y)*COS(Z):READ D:DATA 1,2,3
+10120 ON K GOTO 1000,1010,1020:A$=LEFT$(B$,3)+"X"
+10130 FOR I=1 TO 10:T=T+I:NEXT I:FOR I=1 TO 10:T=T+I:NEXT I
+10140 PRINT "TOTAL";T:PRINT "TOTAL";T
+10150 REM KEEP THIS LINE:FOR I=1 TO 10:T=T+I:NEXT I
+10160 A$=LEFT$(B$,3)+"X":IF A>B THEN A=B
+10170 DIM Q(20):GOSUB 20000
+10180 PRINT "TOTAL";T:IF A>B THEN A=B
+10190 GOSUB 20000:Y=INT(RND(1)*100)
+10200 A$=LEFT$(B$,3)+"X":PRINT TAB(10);"HELLO";
+10210 S$=STR$(N)+CHR$(13):ON K GOTO 1000,1010,1020
+10220 ON K GOTO 1000,1010,1020:PRINT TAB(10);"HELLO";
+10230 READ D:DATA 1,2,3:X=SIN(Y)*COS(Z)
+10240 PRINT TAB(10);"HELLO";:ON K GOTO 1000,1010,1020
+10250 REM KEEP THIS LINE:Y=INT(RND(1)*100)
+10260 DIM Q(20):IF A>B THEN A=B
+10270 GOSUB 20000:READ D:DATA 1,2,3
+10280 S$=STR$(N)+CHR$(13):FOR I=1 TO 10:T=T+I:NEXT I
+10290 X=SIN(Y)*COS(Z):DIM Q(20)
+10300 REM KEEP THIS LINE:IF A>B THEN A=B
+10310 S$=STR$(N)+CHR$(13):X=SIN(Y)*COS(Z)
+10320 REM KEEP THIS LINE:REM KEEP THIS LINE
+10330 ON K GOTO 1000,1010,1020:Y=INT(RND(1)*100)
+10340 POKE 768,N AND 255:FOR I=1 TO 10:T=T+I:NEXT I
+10350 Y=INT(RND(1)*100):POKE 768,N AND 255
+10360 IF A>B THEN A=B:REM KEEP THIS LINE
+10370 X=SIN(Y)*COS(Z):READ D:DATA 1,2,3
+10380 PRINT TAB(10);"HELLO";:REM KEEP THIS LINE
+10390 A$=LEFT$(B$,3)+"X":FOR I=1 TO 10:T=T+I:NEXT I
+10400 A$=LEFT$(B$,3)+"X":S$=STR$(N)+CHR$(13)
+10410 REM KEEP THIS LINE:ON K GOTO 1000,1010,1020
+10420 PRINT TAB(10);"HELLO";:X=SIN(Y)*COS(Z)
+10430 REM KEEP THIS LINE:Y=INT(RND(1)*100)
+10440 GOSUB 20000:X=SIN(Y)*COS(Z)
+10450 PRINT TAB(10);"HELLO";:POKE 768,N AND 255
+10460 PRINT "TOTAL";T:Y=INT(RND(1)*100)
+10470 GOSUB 20000:Y=INT(RND(1)*100)
+10480 ON K GOTO 1000,1010,1020:PRINT TAB(10);"HELLO";
+10490 PRINT TAB(10);"HELLO";:X=SIN(Y)*COS(Z)
+10500 ON K GOTO 1000,1010,1020:REM KEEP THIS LINE
+10510 PRINT TAB(10);"HELLO";:S$=STR$(N)+CHR$(13)
+10520 REM KEEP THIS LINE:ON K GOTO 1000,1010,1020
+10530 X=SIN(Y)*COS(Z):Y=INT(RND(1)*100)
+10540 ON K GOTO 1000,1010,1020:X=SIN(Y)*COS(Z)
+10550 IF A>B THEN A=B:PRINT TAB(10);"HELLO";
+10560 ON K GOTO 1000,1010,1020:A$=LEFT$(B$,3)+"X"
+10570 Y=INT(RND(1)*100):A$=LEFT$(B$,3)+"X"
+10580 PRINT "TOTAL";T:POKE 768,N AND 255
+10590 READ D:DATA 1,2,3:PRINT "TOTAL";T
+10600 A$=LEFT$(B$,3)+"X":POKE 768,N AND 255
+10610 DIM Q(20):FOR I=1 TO 10:T=T+I:NEXT I
+10620 PRINT TAB(10);"HELLO";:PRINT TAB(10);"HELLO";
+10630 ON K GOTO 1000,1010,1020:READ D:DATA 1,2,3
+10640 IF A>B THEN A=B:FOR I=1 TO 10:T=T+I:NEXT I
+10650 PRINT "TOTAL";T:Y=INT(RND(1)*100)
+10660 IF A>B THEN A=B:PRINT TAB(10);"HELLO";
+10670 FOR I=1 TO 10:T=T+I:NEXT I:ON K GOTO 1000,1010,1020
+10680 GOSUB 20000:IF A>B THEN A=B
+10690 X=SIN(Y)*COS(Z):X=SIN(Y)*COS(Z)
+10700 Y=INT(RND(1)*100):REM KEEP THIS LINE
+10710 A$=LEFT$(B$,3)+"X":DIM Q(20)
+10720 X=SIN(Y)*COS(Z):Y=INT(RND(1)*100)
+10730 GOSUB 20000:PRINT TAB(10);"HELLO";
+10740 Y=INT(RND(1)*100):X=SIN(Y)*COS(Z)
+10750 REM KEEP THIS LINE:PRINT TAB(10);"HELLO";
+10760 FOR I=1 TO 10:T=T+I:NEXT I:X=SIN(Y)*COS(Z)
+10770 ON K GOTO 1000,1010,1020:READ D:DATA 1,2,3
+10780 PRINT TAB(10);"HELLO";:POKE 768,N AND 255
+10790 A$=LEFT$(B$,3)+"X":REM KEEP THIS LINE
+10800 POKE 768,N AND 255:DIM Q(20)
+10810 FOR I=1 TO 10:T=T+I:NEXT I:FOR I=1 TO 10:T=T+I:NEXT I
+10820 A$=LEFT$(B$,3)+"X":DIM Q(20)
+10830 IF A>B THEN A=B:POKE 768,N AND 255
+10840 FOR I=1 TO 10:T=T+I:NEXT I:READ D:DATA 1,2,3
+10850 Y=INT(RND(1)*100):A$=LEFT$(B$,3)+"X"
+10860 READ D:DATA 1,2,3:PRINT TAB(10);"HELLO";
+10870 DIM Q(20):GOSUB 20000
+10880 A$=LEFT$(B$,3)+"X":REM KEEP THIS LINE
+10890 REM KEEP THIS LINE:ON K GOTO 1000,1010,1020
+10900 DIM Q(20):PRINT "TOTAL";T
+10910 X=SIN(Y)*COS(Z):A$=LEFT$(B$,3)+"X"
+10920 FOR I=1 TO 10:T=T+I:NEXT I:PRINT "TOTAL";T
+10930 X=SIN(Y)*COS(Z):DIM Q(20)
+10940 Y=INT(RND(1)*100):PRINT "TOTAL";T
+10950 PRINT TAB(10);"HELLO";:PRINT TAB(10);"HELLO";
+10960 Y=INT(RND(1)*100):DIM Q(20)
+10970 DIM Q(20):S$=STR$(N)+CHR$(13)
+10980 FOR I=1 TO 10:T=T+I:NEXT I:FOR I=1 TO 10:T=T+I:NEXT I
+10990 GOSUB 20000:GOSUB 20000
+20000 RETURN
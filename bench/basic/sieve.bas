@@ -0,0 +1,14 @@
+10 REM SIEVE OF ERATOSTHENES, 2 PASSES OVER 2000 NUMBERS
+20 N=2000:DIM F(N)
+30 FOR P=1 TO 2
+40 FOR I=2 TO N:F(I)=0:NEXT I
+50 C=0
+60 FOR I=2 TO N
+70 IF F(I) THEN 100
+80 C=C+1:IF I+I>N THEN 100
+90 FOR J=I+I TO N STEP I:F(J)=1:NEXT J
+100 NEXT I
+110 PRINT "PASS";P;":";C;" PRIMES UP TO";N
+120 NEXT P
+130 FOR I=N-100 TO N:IF F(I)=0 THEN PRINT I;
+140 NEXT I:PRINT
@@ -0,0 +1,12 @@
+10 REM INSERTION SORT OF 150 PSEUDO RANDOM NUMBERS
+20 N=150:DIM A(N)
+30 S=12345
+40 FOR I=1 TO N:S=S*75+74:S=S-INT(S/65537)*65537:A(I)=S:NEXT I
+50 FOR I=2 TO N:V=A(I):J=I-1
+60 IF J<1 THEN 90
+70 IF A(J)<=V THEN 90
+80 A(J+1)=A(J):J=J-1:GOTO 60
+90 A(J+1)=V:NEXT I
+100 FOR I=2 TO N:IF A(I-1)>A(I) THEN PRINT "NOT SORTED AT";I
+110 NEXT I
+120 FOR I=1 TO N STEP 15:PRINT A(I);:NEXT I:PRINT
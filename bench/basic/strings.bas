@@ -0,0 +1,11 @@
+10 REM STRING CONCATENATION AND SLICING, 30 ROUNDS
+20 FOR R=1 TO 30
+30 A$=""
+40 FOR I=1 TO 100:A$=A$+CHR$(65+I-INT(I/26)*26):NEXT I
+50 B$=MID$(A$,R,20)+LEFT$(A$,5)+RIGHT$(A$,5)
+60 C$=C$+LEFT$(B$,1):IF LEN(C$)>200 THEN C$=""
+70 NEXT R
+80 PRINT A$
+90 PRINT B$;LEN(A$);LEN(B$)
+100 PRINT C$
+110 FOR I=1 TO 12:PRINT STR$(I*I);:NEXT I:PRINT
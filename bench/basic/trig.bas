@@ -0,0 +1,10 @@
+10 REM FLOATING POINT, SIN COS TAN ATN SQR EXP LOG OVER 300 STEPS
+20 S=0:C=0:T=0:A=0:Q=0:L=0
+30 FOR I=1 TO 300
+40 X=I/100
+50 S=S+SIN(X):C=C+COS(X):T=T+TAN(X/4)
+60 A=A+ATN(X):Q=Q+SQR(X):L=L+LOG(X)+EXP(-X)
+70 NEXT I
+80 PRINT S;C;T
+90 PRINT A;Q;L
+100 FOR I=0 TO 8:PRINT INT(SIN(I)*1000);:NEXT I:PRINT
@@ -0,0 +1,55 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+// Host side of the benchmarks, included before the core ("globals.h" turns A, X, PC... into macros
+// that the system headers must not see)
+#include <chrono>
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "globals.h"
+
+/*************************************************************/
+/*************************************************************/
+/************************** BENCH ****************************/
+/*************************************************************/
+/*************************************************************/
+// Engine the core was built with, results of two builds are only comparable on the same one
+static inline const char* _bench_engine() {
+#if defined(CPU_RECOMPILER)
+    return "recompiler";
+#elif defined(CPU_BLOCK_CACHE)
+    return "block cache";
+#elif CPU_DISPATCH == CPU_DISPATCH_THREADED
+    return "threaded";
+#elif CPU_DISPATCH == CPU_DISPATCH_TABLE
+    return "table";
+#else
+    return "switch";
+#endif
+}
+
+// Keeps the process on one host CPU, false where it cannot (macOS has no hard affinity)
+static inline bool _bench_pin(int cpu) {
+#if defined(_WIN32)
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// Host time in ns
+static inline double _bench_now() {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif
@@ -0,0 +1,277 @@
+#include <algorithm>
+#include <vector>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../bench.h"
+#include "core.h"
+
+/*************************************************************/
+/*************************************************************/
+/************************ OPCODE BENCH ***********************/
+/*************************************************************/
+/*************************************************************/
+// One synthetic loop per row of the opcode table, timed with _cpu_exec on 64KB of plain RAM:
+//    opcodes [-n instructions] [-reps n] [-warmup n] [-cpu n] [-json file]
+//    -n       instructions of a timed run (default BENCH_INSTRUCTIONS)
+//    -reps    timed runs per opcode, the best one is reported along with the median (default 5)
+//    -warmup  instructions run before the timed runs (caches, branch predictors, the recompiler)
+//    -cpu     pins the process to that host CPU (Linux / Windows)
+//    -json    also writes the results to the file ("-" for stdout, the table then goes to stderr) for
+//             scripts comparing two builds
+// Every loop is 128 copies of the instruction and a JMP back, operands point at a data area that
+// never holds code: zero page 0x80 (its bytes are the pointers of (ind,X) / (ind),Y, 0x0303), absolute
+// 0x0300, branches to the next instruction. The ones that move PC loop on themselves (JMP, JSR, BRK
+// through its vector, RTS / RTI on a stack page filled with their own address). KIL is left out
+#define BENCH_INSTRUCTIONS      1000000
+#define BENCH_COPIES            128
+#define BENCH_CODE              0x1000
+#define BENCH_DATA              0x0300
+#define BENCH_ZP                0x80
+#define BENCH_POINTER           0x03            // Every byte of zero page, pointers to 0x0303
+#define BENCH_STACK             0x20            // Every byte of the stack, RTS returns to 0x2021, RTI to 0x2020
+#define BENCH_JMP_POINTER       0x0600
+
+stCPU g_cpu;
+
+static u8 _bench_ram[0x10000];
+
+struct stBenchBus {
+    static CPU_INLINE u8    read(u16 addr)              { return _bench_ram[addr]; }
+    static CPU_INLINE void  write(u16 addr, u8 data)    { _bench_ram[addr] = data; }
+};
+
+typedef stCore<stBenchBus> stBenchCore;
+
+typedef struct {
+    u8 OpCode;
+    const char* Mnemonic;
+    const char* Mode;                  // ADDR_* of the table
+    u8 Operand;                        // CPU_OPERAND_KIND
+    u8 Cycles;
+} stBenchOp;
+
+#define INSTR_CASE(id, mnemonic, addr_handler, size, cycles, page_cycles, handler) { id, mnemonic, #addr_handler, stBenchCore::addr_handler::Operand, cycles },
+static const stBenchOp _bench_ops[256] = {
+    #include "opcodes.h"
+};
+#undef INSTR_CASE
+
+typedef struct {
+    const stBenchOp* Op;
+    double Best;                       // ns per instruction
+    double Median;
+    double MHz;                        // Emulated clock of the best run
+} stBenchResult;
+
+// "absolute_x" for ADDR_ABSOLUTE_X
+static const char* _bench_mode(const stBenchOp& op) {
+    static char mode[32];
+    const char* name = op.Mode + 5;
+    size_t i = 0;
+    for (; name[i] && i + 1 < sizeof(mode); ++i) {
+        mode[i] = (char)tolower((unsigned char)name[i]);
+    }
+    mode[i] = 0;
+    return mode;
+}
+
+static void _bench_put16(u16 addr, u16 value) {
+    _bench_ram[addr] = value & 0xFF;
+    _bench_ram[addr + 1] = value >> 8;
+}
+
+// Lays the loop of op out in RAM, from start to last, and resets the CPU on it
+static void _bench_setup(const stBenchOp& op, u16* start_addr, u16* last) {
+    memset(_bench_ram, 0, sizeof(_bench_ram));
+    memset(_bench_ram, BENCH_POINTER, 0x100);
+    memset(_bench_ram + 0x100, BENCH_STACK, 0x100);
+
+    u16 start = BENCH_CODE;
+    u16 pc = start;
+    switch (op.OpCode) {
+        case 0x00:                  // BRK, the IRQ vector points back at it
+            _bench_ram[pc] = op.OpCode;
+            _bench_put16(INTERRUPT_IRQ_VECTOR, start);
+            pc += 1;
+            break;
+        case 0x20:                  // JSR / JMP to themselves
+        case 0x4c:
+            _bench_ram[pc] = op.OpCode;
+            _bench_put16(pc + 1, start);
+            pc += 3;
+            break;
+        case 0x6c:
+            _bench_ram[pc] = op.OpCode;
+            _bench_put16(pc + 1, BENCH_JMP_POINTER);
+            _bench_put16(BENCH_JMP_POINTER, start);
+            pc += 3;
+            break;
+        case 0x40:                  // RTI pulls P then BENCH_STACK * 0x101
+            start = pc = BENCH_STACK * 0x101;
+            _bench_ram[pc++] = op.OpCode;
+            break;
+        case 0x60:                  // RTS pulls BENCH_STACK * 0x101 and adds 1
+            start = pc = BENCH_STACK * 0x101 + 1;
+            _bench_ram[pc++] = op.OpCode;
+            break;
+        default:
+            for (int i = 0; i < BENCH_COPIES; ++i) {
+                _bench_ram[pc++] = op.OpCode;
+                switch (op.Operand) {
+                    case stBenchCore::OPERAND_BYTE:
+                        _bench_ram[pc++] = BENCH_ZP;
+                        break;
+                    case stBenchCore::OPERAND_WORD:
+                        _bench_put16(pc, BENCH_DATA);
+                        pc += 2;
+                        break;
+                    case stBenchCore::OPERAND_IMMEDIATE:
+                    case stBenchCore::OPERAND_RELATIVE:
+                        _bench_ram[pc++] = 0x00;
+                        break;
+                }
+            }
+            _bench_ram[pc] = 0x4c;
+            _bench_put16(pc + 1, start);
+            pc += 3;
+            break;
+    }
+    _bench_put16(INTERRUPT_RST_VECTOR, start);
+
+    stBenchCore::_cpu_init();
+#ifdef CPU_MEMORY_MAP
+    stBenchCore::_cpu_mapRAM(0x0000, 0x10000, _bench_ram);
+#endif
+    stBenchCore::_cpu_reset();
+    *start_addr = start;
+    *last = pc - 1;
+}
+
+static u16 _bench_pc() {
+    stCPU& cpu = CPU;
+    return PC;
+}
+
+static void _bench_json(FILE* file, const std::vector<stBenchResult>& results, u32 instructions, u32 reps, u32 warmup, int cpu) {
+    fprintf(file, "{\n");
+    fprintf(file, "  \"benchmark\": \"opcodes\",\n");
+    fprintf(file, "  \"engine\": \"%s\",\n", _bench_engine());
+#ifdef CPU_LAZY_FLAGS
+    fprintf(file, "  \"lazy_flags\": true,\n");
+#else
+    fprintf(file, "  \"lazy_flags\": false,\n");
+#endif
+    fprintf(file, "  \"instructions\": %u,\n", instructions);
+    fprintf(file, "  \"repetitions\": %u,\n", reps);
+    fprintf(file, "  \"warmup\": %u,\n", warmup);
+    fprintf(file, "  \"cpu\": %d,\n", cpu);
+    fprintf(file, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const stBenchResult& result = results[i];
+        fprintf(file, "    { \"opcode\": \"0x%02x\", \"mnemonic\": \"%s\", \"mode\": \"%s\", \"cycles\": %u, \"ns\": %.3f, \"ns_median\": %.3f, \"mhz\": %.2f }%s\n",
+                result.Op->OpCode, result.Op->Mnemonic, _bench_mode(*result.Op), result.Op->Cycles,
+                result.Best, result.Median, result.MHz, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n");
+    fprintf(file, "}\n");
+}
+
+int main(int argc, char** argv) {
+    u32 instructions = BENCH_INSTRUCTIONS;
+    u32 reps = 5;
+    u32 warmup = 100000;
+    int cpu = -1;
+    const char* json = NULL;
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 < argc && !strcmp(argv[i], "-n")) {
+            instructions = (u32)strtoul(argv[i + 1], NULL, 0);
+        }
+        else if (i + 1 < argc && !strcmp(argv[i], "-reps")) {
+            reps = (u32)strtoul(argv[i + 1], NULL, 0);
+        }
+        else if (i + 1 < argc && !strcmp(argv[i], "-warmup")) {
+            warmup = (u32)strtoul(argv[i + 1], NULL, 0);
+        }
+        else if (i + 1 < argc && !strcmp(argv[i], "-cpu")) {
+            cpu = atoi(argv[i + 1]);
+        }
+        else if (i + 1 < argc && !strcmp(argv[i], "-json")) {
+            json = argv[i + 1];
+        }
+        else {
+            fprintf(stderr, "usage: %s [-n instructions] [-reps n] [-warmup n] [-cpu n] [-json file]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (!instructions || !reps) {
+        fprintf(stderr, "-n and -reps must be at least 1\n");
+        return 1;
+    }
+    if (cpu >= 0 && !_bench_pin(cpu)) {
+        fprintf(stderr, "Cannot pin to CPU %d\n", cpu);
+        return 1;
+    }
+
+    // Only the JSON on stdout when it goes there
+    FILE* table = json && !strcmp(json, "-") ? stderr : stdout;
+    fprintf(table, "%s engine, %u instructions x %u runs per opcode\n", _bench_engine(), instructions, reps);
+    std::vector<stBenchResult> results;
+    std::vector<double> times(reps);
+    int failed = 0;
+    for (int i = 0; i < 256; ++i) {
+        const stBenchOp& op = _bench_ops[i];
+        if (!strcmp(op.Mnemonic, "KIL")) {
+            continue;
+        }
+        u16 start;
+        u16 last;
+        _bench_setup(op, &start, &last);
+        if (warmup) {
+            stBenchCore::_cpu_exec(warmup);
+        }
+        u32 best = 0;
+        u32 bestCycles = 0;
+        for (u32 r = 0; r < reps; ++r) {
+            double begin = _bench_now();
+            u32 cycles = stBenchCore::_cpu_exec(instructions);
+            times[r] = (_bench_now() - begin) / instructions;
+            if (!r || times[r] < times[best]) {
+                best = r;
+                bestCycles = cycles;
+            }
+        }
+        // Still inside its loop, otherwise the layout does not match what the core executed
+        u16 pc = _bench_pc();
+        if (CPU.Halted || pc < start || pc > last) {
+            fprintf(stderr, "0x%02x %s left its loop (PC %04x)\n", op.OpCode, op.Mnemonic, pc);
+            failed++;
+            continue;
+        }
+        std::vector<double> sorted(times);
+        std::sort(sorted.begin(), sorted.end());
+        stBenchResult result;
+        result.Op = &op;
+        result.Best = times[best];
+        result.Median = sorted[reps / 2];
+        result.MHz = (double)bestCycles / (result.Best * instructions) * 1000.0;
+        results.push_back(result);
+        fprintf(table, "%02x %s %-12s %8.3f ns %8.3f ns median %10.2f MHz\n", op.OpCode, op.Mnemonic, _bench_mode(op),
+                result.Best, result.Median, result.MHz);
+    }
+
+    if (json) {
+        FILE* file = strcmp(json, "-") ? fopen(json, "w") : stdout;
+        if (!file) {
+            fprintf(stderr, "Cannot write %s\n", json);
+            return 1;
+        }
+        _bench_json(file, results, instructions, reps, warmup, cpu);
+        if (file != stdout) {
+            fclose(file);
+        }
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,19 @@
+#ifndef __USER_DEFINES_H__
+#define __USER_DEFINES_H__
+
+// The opcode benchmark includes "core.h" and runs it on stBenchBus (64KB of plain RAM, inlined into
+// the handlers), there is no BUS_READ / BUS_WRITE and no cpu.cpp. The engine is picked on the command
+// line (-DCPU_DISPATCH=1, -DCPU_BLOCK_CACHE, -DCPU_RECOMPILER, -DCPU_LAZY_FLAGS...). The block cache
+// decodes from the memory map, with it the RAM is also mapped
+
+#if defined(CPU_BLOCK_CACHE) || defined(CPU_RECOMPILER)
+#define CPU_MEMORY_MAP
+#endif
+
+#include "cpu.h"
+
+extern stCPU g_cpu;
+
+#define CPU                      g_cpu
+
+#endif
@@ -1,12 +1,17 @@
+#ifdef _WIN32
 #include <conio.h>
+#endif
 #include <iostream>
+#include <string.h>
 
 #include "defines.h"
 #include "globals.h"
 #include "cpu.h"
+#include "throttle.h"
+#include "snapshot.h"
 
 
-int main(void) {
+int main(int argc, char** argv) {
     /* COLOR [background][foreground]
             0 = Black 
             8 = Gray 
@@ -35,24 +40,67 @@ int main(void) {
 #ifdef _WIN32
     system("Color 1F");
 #endif
-    _console_init();
+    // 6502 [-rom image] [-snapshot file]
+    //    -rom       16KB image run at 0xC000 instead of the one compiled in
+    //    -snapshot  starts at the Ready prompt from the snapshot, it is made (cold start) when there is none or
+    //               it is refused
+    const char* rom = NULL;
+    const char* snapshot = NULL;
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 < argc && !strcmp(argv[i], "-rom")) {
+            rom = argv[i + 1];
+        }
+        else if (i + 1 < argc && !strcmp(argv[i], "-snapshot")) {
+            snapshot = argv[i + 1];
+        }
+        else {
+            std::cerr << "usage: " << argv[0] << " [-rom image] [-snapshot file]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (!_console_init(rom)) {
+        std::cerr << "Cannot load the ROM image " << rom << std::endl;
+        return 1;
+    }
     _cpu_reset();
-    
-    i16 instr_count;
-    while (true) {
-#ifdef _WIN32
-        if (_kbhit()) {
-            _input_key = _getch();
-            if (_input_key >= 0x61 && _input_key <= 0x7A) {
-                _input_key -= 0x20;
+    if (snapshot) {
+        if (_snapshot_load(snapshot, &CPU, _ram_, _console_romId())) {
+            _cpu_flushCache();
+        }
+        else {
+            // A snapshot that is there but refused is replaced, say so and why
+            if (_snapshot_error()) {
+                std::cerr << "Snapshot " << snapshot << " refused (" << _snapshot_error() << "), it is replaced by a cold start"
+                          << std::endl;
+            }
+            _console_boot();
+            if (!_snapshot_save(snapshot, &CPU, _ram_, _console_romId())) {
+                std::cerr << "Cannot save the snapshot " << snapshot << ": " << _snapshot_error() << std::endl;
             }
         }
+    }
+#ifndef _WIN32
+    _input_start(0);
 #endif
-        // Execute instr_count instructions, we don't want one by one since that will slow down things quite a lot
-        instr_count = 30000;
-        while (instr_count--) {
-            _cpu_step(); 
+
+    // Real time at CPU_FREQUENCY
+    stThrottle throttle;
+    _throttle_init(&throttle, CPU_FREQUENCY, CPU.Cycles);
+
+    // Until the program halts the CPU (KIL)
+    while (!CPU.Halted) {
+#ifdef _WIN32
+        // Keys stay in the console buffer while the queue is full
+        while (!_input_full() && _kbhit()) {
+            _input_push((u8)_getch());
         }
+#endif
+        // Execute a burst of cycles, we don't want one by one since that will slow down things quite a lot,
+        // the throttle gives the cycles the CPU is behind the host clock and waits for it when it is ahead
+        _cpu_run(_throttle_budget(&throttle, CPU.Cycles));
+        _output_flush();
+        _throttle_wait(&throttle, CPU.Cycles);
     }
 
     return 0;
@@ -0,0 +1,386 @@
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "defines.h"
+#include "globals.h"
+#include "cpu.h"
+#include "profile.h"
+#include "snapshot.h"
+#include "stats.h"
+
+/*************************************************************/
+/*************************************************************/
+/************************** RUNNER ***************************/
+/*************************************************************/
+/*************************************************************/
+// Runs BASIC programs without a console, one job after the other in the same process. Every job
+// starts from the Ready prompt (cold started once, or loaded from the snapshot), the program is typed
+// in followed by RUN and the lines of the input file, and what the guest prints from RUN on is kept in
+// memory. A job ends when
+//    - its output holds the -until text (what the guest printed after it is dropped, the output is
+//      ended with a line break so the next job starts on a line of its own)
+//    - the program is back at the Ready prompt, input lines it did not ask for are not typed at the
+//      prompt but reported as unused
+//    - everything was typed and the guest waits for a key (an INPUT left unanswered)
+//    - it ran the -cycles limit
+//    - the CPU halted on a KIL opcode
+// The output of the jobs goes to the -output file (stdout without it), in order, and a line per job to
+// stderr with the cycles it ran, the host time they took and the clock that makes. Exits with 2 when a
+// job hit the cycle limit or a KIL, 1 when a file could not be read. Built with CPU_STATS, -stats
+// writes the opcode counters of all the jobs (the boot is not counted). -profile samples the jobs at
+// PROFILE_HZ (see profile.h) and writes collapsed stacks for flame graphs. Built with CPU_CALLGRAPH,
+// -calls writes the calls and cycles of every subroutine the jobs ran
+#define RUNNER_BURST            100000          // Cycles between two checks of the stop conditions
+#define RUNNER_CYCLES           10000000000ull  // Default limit of a job, 10000s of guest time at 1MHz
+#define RUNNER_READY_TEXT       "Ready\r\n"     // What EhBASIC prints once a program ended
+
+enum {
+    RUNNER_READY,
+    RUNNER_UNTIL,
+    RUNNER_LIMIT,
+    RUNNER_KIL
+};
+
+static const char* _runner_results[] = { "ready", "until", "cycle limit", "KIL" };
+
+// Machine at the Ready prompt, every job starts from it
+static stCPU _runner_cpu;
+static u8 _runner_ram[RAM_SIZE];
+
+// Output of the running job, cut after the first -until text
+static std::string _runner_output;
+static std::string _runner_until;
+static bool _runner_found;
+static bool _runner_typing;                     // The program is typed in, its echo is dropped
+
+static void _runner_capture(const u8* data, u32 size) {
+    if (_runner_found || _runner_typing) {
+        return;
+    }
+    // The text can start in an earlier flush
+    size_t from = _runner_output.size() > _runner_until.size() ? _runner_output.size() - _runner_until.size() : 0;
+    _runner_output.append((const char*)data, size);
+    if (!_runner_until.empty()) {
+        size_t at = _runner_output.find(_runner_until, from);
+        if (at != std::string::npos) {
+            _runner_output.resize(at + _runner_until.size());
+            _runner_found = true;
+        }
+    }
+}
+
+static bool _runner_file(const char* path, std::string* text) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    *text = content.str();
+    return true;
+}
+
+// Keys as the console reader types them, lines end on CR. The guest gets them one line at a time, the
+// next one once it waits for a key again: EhBASIC reads (and drops) a key now and then while a program
+// runs, to catch Ctrl-C, what is typed ahead of an INPUT would be lost
+static void _runner_lines(std::vector<std::string>* lines, const std::string& text) {
+    std::string line;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '\r') {
+            continue;
+        }
+        if (text[i] == '\n') {
+            lines->push_back(line + '\r');
+            line.clear();
+        }
+        else {
+            line += text[i];
+        }
+    }
+    if (!line.empty()) {
+        lines->push_back(line + '\r');
+    }
+}
+
+static bool _runner_at_ready() {
+    size_t size = strlen(RUNNER_READY_TEXT);
+    return _runner_output.size() >= size && !_runner_output.compare(_runner_output.size() - size, size, RUNNER_READY_TEXT);
+}
+
+// lines[0] is the program, typed at once (BASIC only stores it), lines[1] RUN. unused is the number of
+// input lines left when the program ended
+static int _runner_job(const std::vector<std::string>& lines, u64 limit, u64* cycles, size_t* unused) {
+    CPU = _runner_cpu;
+    memcpy(_ram_, _runner_ram, RAM_SIZE);
+    _cpu_flushCache();
+#ifdef CPU_CALLGRAPH
+    _cpu_dropCalls();
+#endif
+    _input_clear();
+    _runner_output.clear();
+    _runner_found = false;
+    _runner_typing = true;
+
+    *unused = 0;
+    u64 start = CPU.Cycles;
+    size_t line = 0;
+    size_t typed = 0;
+    int result;
+    for (;;) {
+        // The input queue is smaller than most programs, it is topped up between bursts
+        while (typed < lines[line].size() && _input_push((u8)lines[line][typed])) {
+            typed++;
+        }
+        u64 left = limit - (CPU.Cycles - start);
+        _cpu_run(left < RUNNER_BURST ? (u32)left : RUNNER_BURST);
+        _profile_sample(&CPU, _console_peek);
+        _output_flush();
+        if (_runner_found) {
+            result = RUNNER_UNTIL;
+            break;
+        }
+        if (CPU.Halted) {
+            result = RUNNER_KIL;
+            break;
+        }
+        if (typed == lines[line].size() && _input_waiting()) {
+            // Past RUN, the rest would be typed at the prompt as new program lines
+            if (line + 1 == lines.size() || (line >= 1 && _runner_at_ready())) {
+                *unused = lines.size() - line - 1;
+                result = RUNNER_READY;
+                break;
+            }
+            _runner_typing = false;
+            line++;
+            typed = 0;
+        }
+        if (CPU.Cycles - start >= limit) {
+            result = RUNNER_LIMIT;
+            break;
+        }
+    }
+    *cycles = CPU.Cycles - start;
+    return result;
+}
+
+static void _runner_report(const char* name, const char* result, u64 cycles, double seconds) {
+    fprintf(stderr, "%s: %s, %llu cycles in %.3fms, %.2fMHz\n", name, result, (unsigned long long)cycles,
+            seconds * 1000.0, seconds > 0.0 ? (double)cycles / seconds / 1000000.0 : 0.0);
+}
+
+int main(int argc, char** argv) {
+    // runner [-rom image] [-snapshot file] [-input file] [-output file] [-until text] [-cycles n] [-profile file] [-symbols file] [-stats file] [-calls file] program.bas...
+    //    -rom       16KB image run at 0xC000 instead of the one compiled in
+    //    -snapshot  the jobs start from the snapshot, it is made (cold start) when there is none
+    //    -input     lines typed after RUN (answers to INPUT)
+    //    -output    file the output of the jobs is written to instead of stdout
+    //    -until     text that ends a job once the guest printed it
+    //    -cycles    limit of a job, RUNNER_CYCLES by default
+    //    -profile   file the samples of the jobs are written to, collapsed stacks
+    //    -symbols   labels of the ROM for the profile, one per line ("LAB_1234 = $C1A2")
+    //    -stats     CPU_STATS only, file the counters are written to, CSV when it ends in .csv, a
+    //               histogram otherwise ("-" for stderr)
+    //    -calls     CPU_CALLGRAPH only, file the subroutine totals are written to ("-" for stderr)
+    const char* rom = NULL;
+    const char* snapshot = NULL;
+    const char* input = NULL;
+    const char* output = NULL;
+    const char* until = NULL;
+    const char* profile = NULL;
+    const char* symbols = NULL;
+    const char* stats = NULL;
+    const char* calls = NULL;
+    u64 limit = RUNNER_CYCLES;
+    int first = 1;
+    for (; first + 1 < argc && argv[first][0] == '-'; first += 2) {
+        if (!strcmp(argv[first], "-rom")) {
+            rom = argv[first + 1];
+        }
+        else if (!strcmp(argv[first], "-snapshot")) {
+            snapshot = argv[first + 1];
+        }
+        else if (!strcmp(argv[first], "-input")) {
+            input = argv[first + 1];
+        }
+        else if (!strcmp(argv[first], "-output")) {
+            output = argv[first + 1];
+        }
+        else if (!strcmp(argv[first], "-until")) {
+            until = argv[first + 1];
+        }
+        else if (!strcmp(argv[first], "-cycles")) {
+            limit = strtoull(argv[first + 1], NULL, 0);
+        }
+        else if (!strcmp(argv[first], "-profile")) {
+            profile = argv[first + 1];
+        }
+        else if (!strcmp(argv[first], "-symbols")) {
+            symbols = argv[first + 1];
+        }
+#ifdef CPU_STATS
+        else if (!strcmp(argv[first], "-stats")) {
+            stats = argv[first + 1];
+        }
+#endif
+#ifdef CPU_CALLGRAPH
+        else if (!strcmp(argv[first], "-calls")) {
+            calls = argv[first + 1];
+        }
+#endif
+        else {
+            break;
+        }
+    }
+    if (first >= argc || argv[first][0] == '-' || !limit) {
+        fprintf(stderr, "usage: %s [-rom image] [-snapshot file] [-input file] [-output file] [-until text] [-cycles n] [-profile file] [-symbols file] [-stats file] [-calls file] program.bas...\n", argv[0]);
+        return 1;
+    }
+
+    std::string script;
+    if (input && !_runner_file(input, &script)) {
+        fprintf(stderr, "Cannot read %s\n", input);
+        return 1;
+    }
+    std::vector<std::string> answers;
+    _runner_lines(&answers, script);
+    FILE* out = output ? fopen(output, "wb") : stdout;
+    if (!out) {
+        fprintf(stderr, "Cannot write %s\n", output);
+        return 1;
+    }
+
+    if (!_console_init(rom)) {
+        fprintf(stderr, "Cannot load the ROM image %s\n", rom);
+        return 1;
+    }
+    _console_batch(_runner_capture);
+    _cpu_reset();
+    if (!snapshot || !_snapshot_load(snapshot, &CPU, _ram_, _console_romId())) {
+        if (snapshot && _snapshot_error()) {
+            fprintf(stderr, "Snapshot %s refused (%s), it is replaced by a cold start\n", snapshot, _snapshot_error());
+        }
+        _console_boot();
+        if (snapshot && !_snapshot_save(snapshot, &CPU, _ram_, _console_romId())) {
+            fprintf(stderr, "Cannot save the snapshot %s: %s\n", snapshot, _snapshot_error());
+        }
+    }
+    _output_flush();
+    _runner_cpu = CPU;
+    memcpy(_runner_ram, _ram_, RAM_SIZE);
+    if (until) {
+        _runner_until = until;
+    }
+#ifdef CPU_STATS
+    _cpu_clearStats();
+#endif
+#ifdef CPU_CALLGRAPH
+    _cpu_clearCallGraph();
+#endif
+    if (symbols && !_profile_symbols(symbols)) {
+        fprintf(stderr, "Cannot read %s\n", symbols);
+        return 1;
+    }
+    if (profile && !_profile_start(PROFILE_HZ)) {
+        fprintf(stderr, "No profiling timer on this host\n");
+        return 1;
+    }
+
+    int status = 0;
+    u64 total = 0;
+    double seconds = 0.0;
+    for (int i = first; i < argc; ++i) {
+        std::string program;
+        if (!_runner_file(argv[i], &program)) {
+            fprintf(stderr, "Cannot read %s\n", argv[i]);
+            status = 1;
+            continue;
+        }
+        // The program as one line of keys, then RUN and the input
+        std::vector<std::string> lines;
+        _runner_lines(&lines, program);
+        std::string code;
+        for (size_t n = 0; n < lines.size(); ++n) {
+            code += lines[n];
+        }
+        lines.assign(1, code);
+        lines.push_back("RUN\r");
+        lines.insert(lines.end(), answers.begin(), answers.end());
+
+        u64 cycles;
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        size_t unused;
+        int result = _runner_job(lines, limit, &cycles, &unused);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        if (result == RUNNER_UNTIL && _runner_output[_runner_output.size() - 1] != '\n') {
+            _runner_output += "\r\n";
+        }
+        fwrite(_runner_output.data(), 1, _runner_output.size(), out);
+        _runner_report(argv[i], _runner_results[result], cycles, elapsed);
+        if (unused) {
+            fprintf(stderr, "%s: %u input lines not used\n", argv[i], (u32)unused);
+        }
+        total += cycles;
+        seconds += elapsed;
+        if (result == RUNNER_LIMIT || result == RUNNER_KIL) {
+            status = status ? status : 2;
+        }
+    }
+    if (argc - first > 1) {
+        _runner_report("total", "done", total, seconds);
+    }
+    if (out != stdout) {
+        fclose(out);
+    }
+    if (profile) {
+        _profile_stop();
+        if (!_profile_write(profile)) {
+            fprintf(stderr, "Cannot write %s\n", profile);
+            return 1;
+        }
+        fprintf(stderr, "%llu samples in %s\n", (unsigned long long)_profile_samples(), profile);
+    }
+#ifdef CPU_STATS
+    if (stats) {
+        FILE* file = strcmp(stats, "-") ? fopen(stats, "w") : stderr;
+        if (!file) {
+            fprintf(stderr, "Cannot write %s\n", stats);
+            return 1;
+        }
+        size_t length = strlen(stats);
+        if (length > 4 && !strcmp(stats + length - 4, ".csv")) {
+            _stats_csv(file, _cpu_getStats());
+        }
+        else {
+            _stats_histogram(file, _cpu_getStats());
+        }
+        if (file != stderr) {
+            fclose(file);
+        }
+    }
+#else
+    UNUSED(stats);
+#endif
+#ifdef CPU_CALLGRAPH
+    if (calls) {
+        FILE* file = strcmp(calls, "-") ? fopen(calls, "w") : stderr;
+        if (!file) {
+            fprintf(stderr, "Cannot write %s\n", calls);
+            return 1;
+        }
+        _profile_calls(file, _cpu_getCallGraph());
+        if (file != stderr) {
+            fclose(file);
+        }
+    }
+#else
+    UNUSED(calls);
+#endif
+    return status;
+}
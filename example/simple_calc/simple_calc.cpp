@@ -1,6 +1,24 @@
+#include "user_defines.h"
 #include "simple_calc.h"
 #include "defines.h"
+#include "ring.h"
 #include <stdio.h>
+#include <errno.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#define write                   _write
+#else
+#include <stdlib.h>
+#include <signal.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
 
 /*************************************************************/
 /*************************************************************/
@@ -9,19 +27,185 @@
 /*************************************************************/
 u8 _ram_[RAM_SIZE];
 
-u8 _input_key;
+/*************************************************************/
+/*************************************************************/
+/************************** OUTPUT ***************************/
+/*************************************************************/
+/*************************************************************/
+// Characters written to 0xF001 are queued and reach the console in batches, one write per
+// _output_flush. When the ring is full it is flushed right away, the guest waits for the
+// console instead of losing characters
+static stRing _output;
+
+// Batch mode, see _console_batch
+static fpConsoleOutput _output_sink;
+
+// Reads of 0xF004 that found no key since the guest last printed something
+static u32 _input_waits;
+// The core saw the guest polling 0xF004 in a loop (CPU_IDLE_DETECT) since it last printed or got a key
+static bool _input_idle;
+
+void _output_flush() {
+    u8 buffer[RING_SIZE];
+    u32 size = _ring_read(&_output, buffer, sizeof(buffer));
+    if (_output_sink) {
+        if (size) {
+            _output_sink(buffer, size);
+        }
+        return;
+    }
+    // Interrupted writes are retried, a non-blocking stdout that is full is waited on, only an error
+    // (console gone) drops the rest
+    u32 done = 0;
+    while (done < size) {
+        int written = (int)write(1, buffer + done, size - done);
+        if (written > 0) {
+            done += written;
+            continue;
+        }
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+#ifndef _WIN32
+        if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            struct pollfd fd = { 1, POLLOUT, 0 };
+            if (poll(&fd, 1, -1) >= 0 || errno == EINTR) {
+                continue;
+            }
+        }
+#endif
+        break;
+    }
+}
 
 void out(u8 data) {
-    printf("%c", data);
+    _input_waits = 0;
+    _input_idle = false;
+    while (!_ring_push(&_output, data)) {
+        _output_flush();
+    }
 }
 
+/*************************************************************/
+/*************************************************************/
+/*************************** INPUT ***************************/
+/*************************************************************/
+/*************************************************************/
+// Keys wait in _input until the guest reads 0xF004, one per read (0 when there is none). The host
+// pushes them, from the main loop on Windows and from a reader thread on the terminal (or any fd)
+// elsewhere, so typing ahead and pasting lose nothing
+static stRing _input;
+
+bool _input_push(u8 key) {
+    if (key >= 'a' && key <= 'z') {
+        key -= 0x20;                // EhBASIC only knows upper case keywords
+    }
+    return _ring_push(&_input, key);
+}
+
+bool _input_full() {
+    return _ring_count(&_input) == RING_SIZE;
+}
+
+// Everything typed was read and the guest keeps asking for more, it is waiting at a prompt
+bool _input_waiting() {
+    if (_ring_count(&_input)) {
+        return false;
+    }
+#ifdef CPU_IDLE_DETECT
+    return _input_idle;
+#else
+    return _input_waits >= INPUT_WAITING_READS;
+#endif
+}
+
+// Drops the keys not read yet (the guest is not running)
+void _input_clear() {
+    u8 key;
+    while (_ring_pop(&_input, &key)) {
+    }
+    _input_waits = 0;
+    _input_idle = false;
+}
+
+void _console_batch(fpConsoleOutput output) {
+    _output_sink = output;
+}
+
+#ifndef _WIN32
+// The reader thread wakes _bus_idle up when it queued keys
+static std::mutex _input_lock;
+static std::condition_variable _input_ready;
+
+static int _input_tty = -1;
+static struct termios _input_termios;
+
+static void _input_restore() {
+    tcsetattr(_input_tty, TCSANOW, &_input_termios);
+}
+
+static void _input_signal(int sig) {
+    _input_restore();
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+static void _input_reader(int fd) {
+    u8 buffer[256];
+    for (;;) {
+        ssize_t size = read(fd, buffer, sizeof(buffer));
+        if (size < 0 && errno == EINTR) {
+            continue;
+        }
+        if (size <= 0) {
+            break;                  // End of the file / pipe
+        }
+        for (ssize_t i = 0; i < size; ++i) {
+            u8 key = buffer[i];
+            if (key == '\r') {
+                continue;           // CR LF files, the terminal already turns Enter into LF
+            }
+            if (key == '\n') {
+                key = '\r';         // EhBASIC ends a line on CR
+            }
+            while (!_input_push(key)) {
+                usleep(1000);       // The guest is slower than the paste, wait for it
+            }
+        }
+        std::lock_guard<std::mutex> lock(_input_lock);
+        _input_ready.notify_one();
+    }
+}
+
+// A terminal is switched to raw mode (keys come as they are typed and are not echoed, EhBASIC echoes
+// them) until the process ends, a pipe or a file is read as it is
+void _input_start(int fd) {
+    if (isatty(fd) && tcgetattr(fd, &_input_termios) == 0) {
+        _input_tty = fd;
+        struct termios raw = _input_termios;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(fd, TCSANOW, &raw);
+        atexit(_input_restore);
+        signal(SIGINT, _input_signal);
+        signal(SIGTERM, _input_signal);
+    }
+    std::thread(_input_reader, fd).detach();
+}
+#endif
+
 u8 _bus_read(u16 addr)
 {
     // 0xF004 - input
     if (addr == 0xF004) {
-        u8 tmp = _input_key;
-        _input_key = 0;
-        return tmp;
+        u8 key;
+        if (_ring_pop(&_input, &key)) {
+            _input_idle = false;
+            return key;
+        }
+        _input_waits++;
+        return 0;
     }
 
     return (addr < RAM_SIZE) ? _ram_[addr] : 0;
@@ -36,3 +220,28 @@ void _bus_write(u16 addr, u8 data) {
         _ram_[addr] = data;
     }
 }
+
+// The program is waiting for a key (polling 0xF004), sleep until one is pressed or INPUT_IDLE_US went
+// by, then the time slept is skipped up to the cycles the core can skip
+u32 _bus_idle(u32 cycles) {
+    _output_flush();
+    _input_idle = true;
+    if (_output_sink) {
+        return 0;                   // Batch, the burst ends here and the host decides what comes next
+    }
+#ifdef _WIN32
+    DWORD start = GetTickCount();
+    WaitForSingleObject(GetStdHandle(STD_INPUT_HANDLE), INPUT_IDLE_US / 1000);
+    u64 elapsed = (u64)(GetTickCount() - start) * CPU_FREQUENCY / 1000;
+#else
+    // Blocks on the reader thread, no polling
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    {
+        std::unique_lock<std::mutex> lock(_input_lock);
+        _input_ready.wait_for(lock, std::chrono::microseconds(INPUT_IDLE_US), [] { return _ring_count(&_input) != 0; });
+    }
+    u64 us = (u64)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    u64 elapsed = us * CPU_FREQUENCY / 1000000;
+#endif
+    return elapsed < cycles ? (u32)elapsed : cycles;
+}
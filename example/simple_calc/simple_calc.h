@@ -8,12 +8,46 @@
 /************************** CPU RAM **************************/
 /*************************************************************/
 /*************************************************************/
-#define RAM_SIZE                0xFFFF
+#define RAM_SIZE                0x10000
+#ifndef CPU_FREQUENCY
+#define CPU_FREQUENCY           1000000         // Clock of the CPU in real time (see main.cpp and _bus_idle)
+#endif
 
 extern u8 _ram_[RAM_SIZE];
-extern u8 _input_key;
+
+// Empty reads of the input port after which the guest is taken as waiting for a key, only without
+// CPU_IDLE_DETECT (EhBASIC also reads it while a program runs, to catch Ctrl-C, so a long loop that
+// prints nothing looks the same)
+#define INPUT_WAITING_READS     16
+
+// Longest sleep of _bus_idle waiting for a key, whatever the budget of the burst (a 0.5ms throttle slice
+// is far too short to sleep on). The guest clock falls behind by up to this much and the throttle
+// catches it up, keep it under CPU_THROTTLE_MAX_LAG_US
+#ifndef INPUT_IDLE_US
+#define INPUT_IDLE_US           20000
+#endif
 
 extern u8 _bus_read(u16 addr);
 extern void _bus_write(u16 addr, u8 data);
+extern u32 _bus_idle(u32 cycles);
+
+// Writes what the guest printed since the last call to the console (or hands it to the batch output)
+extern void _output_flush();
+
+// Queues a key for 0xF004, false when the queue is full
+extern bool _input_push(u8 key);
+extern bool _input_full();
+extern bool _input_waiting();
+extern void _input_clear();
+#ifndef _WIN32
+// Reads the keys from fd (raw mode when it is a terminal) on a thread of its own
+extern void _input_start(int fd);
+#endif
+
+// Batch mode (runner.cpp) - what the guest prints goes to output at every _output_flush instead of
+// the console, and the guest waiting for a key ends the burst instead of sleeping. NULL goes back to
+// the console
+typedef void (*fpConsoleOutput)(const u8* data, u32 size);
+extern void _console_batch(fpConsoleOutput output);
 
 #endif
@@ -1,15 +1,73 @@
+#include <stdio.h>
+
 #include "user_defines.h"
 #include "ehrom.h"
 #include "simple_calc.h"
+#include "rom.h"
+#include "snapshot.h"
 
 stCPU g_cpu;
 
-void _console_init() {
+// ROM the CPU runs, for _console_peek, and its identity for snapshots
+static const u8* _console_rom;
+static u32 _console_romHash;
+
+// The ROM (0xC000 - 0xFFFF) is the image file when one is given, the copy compiled in (ehrom.h) otherwise
+bool _console_init(const char* rom) {
     _cpu_init();
 
+    const u8* image = EHBASICROM;
+    u32 size = sizeof(EHBASICROM);
+    if (rom) {
+        image = _rom_open(rom, &size);
+        if (!image) {
+            return false;
+        }
+        if (size != sizeof(EHBASICROM)) {
+            fprintf(stderr, "%s is %u bytes, the ROM at 0xC000 is %u\n", rom, size, (u32)sizeof(EHBASICROM));
+            _rom_close(image, size);
+            return false;
+        }
+    }
+
+    _console_rom = image;
+    _console_romHash = _snapshot_rom(image, size);
+#ifdef CPU_MEMORY_MAP
+    // Read straight from the image, the I/O page (0xF001 / 0xF004) stays on the bus
+    _cpu_mapRAM(0x0000, 0xC000, _ram_);
+    _cpu_mapROM(0xC000, 0x3000, image);
+    _cpu_mapROM(0xF100, 0x0F00, image + 0x3100);
+#else
     // Not using memcpy, maybe on a different platform there is no memcpy, also it is happening in init so no performance problem
-    for (int i = 0; i < sizeof(EHBASICROM); ++i) {
-        _ram_[0xC000 + i] = EHBASICROM[i];
+    for (u32 i = 0; i < size; ++i) {
+        _ram_[0xC000 + i] = image[i];
+    }
+#endif
+    return true;
+}
+
+// Cold start with the default memory size, returns once BASIC waits at its Ready prompt
+void _console_boot() {
+    const char* keys = "C\r\r";
+    for (const char* key = keys; *key; ++key) {
+        _input_push(*key);
+    }
+    while (!_input_waiting()) {
+        _cpu_run(10000);
+    }
+}
+
+// Memory as the CPU sees it without reading the I/O page (the profiler walks the stack and the code)
+u8 _console_peek(u16 addr) {
+#ifdef CPU_MEMORY_MAP
+    if (addr >= 0xC000 && (addr < 0xF000 || addr >= 0xF100)) {
+        return _console_rom[addr - 0xC000];
     }
+#endif
+    return _ram_[addr];
+}
 
+// Identity of the ROM given to _console_init, saved in and checked against snapshots
+u32 _console_romId() {
+    return _console_romHash;
 }
@@ -1,6 +1,12 @@
 #ifndef __USER_DEFINES_H__
 #define __USER_DEFINES_H__
 
+// RAM is read and written straight from _ram_ (zero page and stack without even the page lookup),
+// only the I/O page goes through _bus_read / _bus_write. Waiting for a key sleeps in _bus_idle
+#define CPU_MEMORY_MAP
+#define CPU_ZP_STACK_RAM
+#define CPU_IDLE_DETECT
+
 #include "cpu.h"
 #include "simple_calc.h"
 
@@ -10,7 +16,12 @@ extern stCPU g_cpu;
 
 #define BUS_READ                 _bus_read
 #define BUS_WRITE                _bus_write
+#define BUS_IDLE                 _bus_idle
 
-void _console_init();
+// rom is the path of a 16KB image to run instead of the one compiled in, NULL for the compiled one
+bool _console_init(const char* rom);
+void _console_boot();
+u8   _console_peek(u16 addr);
+u32  _console_romId();
 
 #endif